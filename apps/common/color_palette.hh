@@ -1,7 +1,11 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <map>
+#include <utility>
 
 namespace Apps::Common {
 
@@ -15,7 +19,7 @@ enum class EPDColor {
 };
 
 using Color = std::array<uint8_t, 3>;
-const std::map<EPDColor, Color> PALETTE = {
+inline constexpr std::array<std::pair<EPDColor, Color>, 6> PALETTE_COLORS = {{
     {EPDColor::BLACK, {0, 0, 0}},       //
     {EPDColor::WHITE, {255, 255, 255}}, //
     {EPDColor::YELLOW, {255, 255, 0}},  //
@@ -36,6 +40,33 @@ const std::map<EPDColor, Color> PALETTE = {
     //                  // {145, 40, 40},    //
     //                  // {45, 90, 180},    //
     //                  // {65, 110, 65},
-};
+}};
+const std::map<EPDColor, Color> PALETTE(PALETTE_COLORS.begin(),
+                                        PALETTE_COLORS.end());
+
+// Nearest palette entry by squared RGB distance, in integer arithmetic. The
+// first of equally near entries wins. Components may lie outside 0..255, as they
+// do while an error-diffusion ditherer carries error into them.
+inline auto closest_palette_entry(int r, int g, int b)
+    -> const std::pair<EPDColor, Color> & {
+  int best_distance = std::numeric_limits<int>::max();
+  size_t best = 0;
+  for (size_t i = 0; i < PALETTE_COLORS.size(); ++i) {
+    const auto &value = PALETTE_COLORS[i].second;
+    const int dr = r - value[0];
+    const int dg = g - value[1];
+    const int db = b - value[2];
+    const int distance = dr * dr + dg * dg + db * db;
+    if (distance < best_distance) {
+      best_distance = distance;
+      best = i;
+    }
+  }
+  return PALETTE_COLORS[best];
+}
+
+inline auto closest_color(const uint8_t *rgb) -> EPDColor {
+  return closest_palette_entry(rgb[0], rgb[1], rgb[2]).first;
+}
 
 } // namespace Apps::Common
@@ -0,0 +1,225 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "color_palette.hh"
+
+namespace Apps::Common {
+
+// BASE6_RLE wire encoding of a packed 4bpp frame (two pixels per byte, high
+// nibble first) that uses only the six panel colours. Each token byte is
+//   0..215    three pixels as base-6 digits of their colour index, first pixel
+//             most significant; the last token is zero-padded
+//   216..221  a run of colour index (token - 216), followed by its length minus
+//             BASE6_MIN_RUN as a little-endian base-128 varint
+// Flat areas cost a few bytes per run and dithered areas 1/3 byte per pixel, so
+// a frame never grows past 2/3 of its raw size.
+inline constexpr std::array<EPDColor, 6> BASE6_COLORS = {
+    EPDColor::BLACK, EPDColor::WHITE, EPDColor::YELLOW,
+    EPDColor::RED,   EPDColor::BLUE,  EPDColor::GREEN,
+};
+inline constexpr uint8_t BASE6_RUN = 216;
+inline constexpr size_t BASE6_MIN_RUN = 6;
+
+namespace detail {
+
+inline constexpr uint8_t NO_INDEX = 0xFF;
+
+// Colour index of each nibble value.
+inline constexpr auto BASE6_INDEX = [] {
+  std::array<uint8_t, 16> index{};
+  index.fill(NO_INDEX);
+  for (size_t i = 0; i < BASE6_COLORS.size(); ++i) {
+    index[static_cast<uint8_t>(BASE6_COLORS[i])] = static_cast<uint8_t>(i);
+  }
+  return index;
+}();
+
+// Nibble values of the three pixels of each literal token.
+inline constexpr auto BASE6_TRIPLES = [] {
+  std::array<std::array<uint8_t, 3>, BASE6_RUN> triples{};
+  for (size_t token = 0; token < BASE6_RUN; ++token) {
+    triples[token] = {static_cast<uint8_t>(BASE6_COLORS[token / 36]),
+                      static_cast<uint8_t>(BASE6_COLORS[token / 6 % 6]),
+                      static_cast<uint8_t>(BASE6_COLORS[token % 6])};
+  }
+  return triples;
+}();
+
+} // namespace detail
+
+// Returns nothing if a pixel is not one of the six colours; send it raw then.
+inline auto encode_base6_rle(std::span<const uint8_t> packed)
+    -> std::optional<std::vector<uint8_t>> {
+  const size_t pixels = packed.size() * 2;
+  auto pixel = [&](size_t i) -> uint8_t {
+    return i % 2 == 0 ? packed[i / 2] >> 4 : packed[i / 2] & 0x0F;
+  };
+
+  std::vector<uint8_t> out;
+  out.reserve(packed.size() / 3);
+  std::array<uint8_t, 3> literal{};
+  size_t literal_size = 0;
+  auto push_literal = [&](uint8_t index) {
+    literal[literal_size++] = index;
+    if (literal_size == literal.size()) {
+      out.push_back(
+          static_cast<uint8_t>(literal[0] * 36 + literal[1] * 6 + literal[2]));
+      literal_size = 0;
+    }
+  };
+
+  for (size_t i = 0; i < pixels;) {
+    const uint8_t nibble = pixel(i);
+    const uint8_t index = detail::BASE6_INDEX[nibble];
+    if (index == detail::NO_INDEX) {
+      return std::nullopt;
+    }
+    size_t run = 1;
+    while (i + run < pixels && pixel(i + run) == nibble) {
+      ++run;
+    }
+
+    // A pending literal is completed from the run first; tokens never split.
+    const size_t to_fill =
+        literal_size == 0 ? 0 : literal.size() - literal_size;
+    if (run < BASE6_MIN_RUN + to_fill) {
+      push_literal(index);
+      ++i;
+      continue;
+    }
+    for (size_t k = 0; k < to_fill; ++k) {
+      push_literal(index);
+    }
+    i += to_fill;
+    run -= to_fill;
+
+    out.push_back(static_cast<uint8_t>(BASE6_RUN + index));
+    for (size_t extra = run - BASE6_MIN_RUN;; extra >>= 7) {
+      if (extra < 0x80) {
+        out.push_back(static_cast<uint8_t>(extra));
+        break;
+      }
+      out.push_back(static_cast<uint8_t>((extra & 0x7F) | 0x80));
+    }
+    i += run;
+  }
+  while (literal_size != 0) {
+    push_literal(0);
+  }
+  return out;
+}
+
+// Decodes into `packed`. Returns false unless `encoded` is well formed and
+// holds exactly `packed.size() * 2` pixels.
+inline auto decode_base6_rle(std::span<const uint8_t> encoded,
+                             std::span<uint8_t> packed) -> bool {
+  const size_t pixels = packed.size() * 2;
+  size_t p = 0;
+  auto put = [&](uint8_t nibble) {
+    if (p % 2 == 0) {
+      packed[p / 2] = static_cast<uint8_t>(nibble << 4);
+    } else {
+      packed[p / 2] |= nibble;
+    }
+    ++p;
+  };
+
+  for (size_t i = 0; i < encoded.size();) {
+    const uint8_t token = encoded[i++];
+    if (token < BASE6_RUN) {
+      const auto &triple = detail::BASE6_TRIPLES[token];
+      for (size_t k = 0; k < triple.size(); ++k) {
+        if (p == pixels) {
+          // Zero padding, which only the last token may carry.
+          return k != 0 && i == encoded.size() &&
+                 token % (k == 1 ? 36 : 6) == 0;
+        }
+        put(triple[k]);
+      }
+      continue;
+    }
+    if (token >= BASE6_RUN + BASE6_COLORS.size()) {
+      return false;
+    }
+
+    size_t run = 0;
+    for (unsigned shift = 0;; shift += 7) {
+      if (i == encoded.size() || shift > 21) {
+        return false;
+      }
+      const uint8_t byte = encoded[i++];
+      run |= static_cast<size_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) {
+        break;
+      }
+    }
+    run += BASE6_MIN_RUN;
+    if (run > pixels - p) {
+      return false;
+    }
+
+    const auto nibble =
+        static_cast<uint8_t>(BASE6_COLORS[token - BASE6_RUN]);
+    if (p % 2 != 0) {
+      put(nibble);
+      --run;
+    }
+    if (run >= 2) {
+      std::memset(&packed[p / 2], nibble * 0x11, run / 2);
+      p += run / 2 * 2;
+    }
+    if (run % 2 != 0) {
+      put(nibble);
+    }
+  }
+  return p == pixels;
+}
+
+// One changed byte range of a delta frame, XOR-ed against the base frame.
+struct XorRange {
+  size_t offset;
+  std::vector<uint8_t> bits;
+};
+
+// Byte ranges where `frame` differs from `base` (same size). Ranges closer than
+// `merge_gap` bytes are joined, since each one costs a few bytes of framing.
+inline auto diff_frames(std::span<const uint8_t> base,
+                        std::span<const uint8_t> frame, size_t merge_gap = 8)
+    -> std::vector<XorRange> {
+  std::vector<XorRange> ranges;
+  for (size_t i = 0; i < frame.size(); ++i) {
+    if (frame[i] == base[i]) {
+      continue;
+    }
+    if (ranges.empty() ||
+        i - (ranges.back().offset + ranges.back().bits.size()) > merge_gap) {
+      ranges.push_back({i, {}});
+    }
+    auto &range = ranges.back();
+    for (size_t k = range.offset + range.bits.size(); k <= i; ++k) {
+      range.bits.push_back(frame[k] ^ base[k]);
+    }
+  }
+  return ranges;
+}
+
+// XORs `bits` into `frame` at `offset`. Returns false if they do not fit.
+inline auto apply_xor(std::span<uint8_t> frame, size_t offset,
+                      std::span<const uint8_t> bits) -> bool {
+  if (offset > frame.size() || bits.size() > frame.size() - offset) {
+    return false;
+  }
+  for (size_t k = 0; k < bits.size(); ++k) {
+    frame[offset + k] ^= bits[k];
+  }
+  return true;
+}
+
+} // namespace Apps::Common
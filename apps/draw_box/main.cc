@@ -4,27 +4,19 @@
 #include <thread>
 #include <vector>
 
-#include "epd_7in3e.hh"
+#include "epd_driver.hh"
 
-constexpr int SCREEN_WIDTH = 800;
-constexpr int SCREEN_HEIGHT = 480;
-constexpr int PIXELS_PER_BYTE = 2;
-constexpr int BUFFER_SIZE = (SCREEN_WIDTH * SCREEN_HEIGHT) / PIXELS_PER_BYTE;
+using Panel = Epaper::Panel7in3e;
+
+constexpr int SCREEN_WIDTH = Panel::WIDTH;
+constexpr int SCREEN_HEIGHT = Panel::HEIGHT;
+constexpr size_t BUFFER_SIZE = Panel::FRAME_BYTES;
 
 using Buffer = std::vector<uint8_t>;
 
 // pixel 単位の位置 (x, y) に value を描く
 void set_pixel(Buffer &buf, int x, int y, uint8_t value) {
-  if (x < 0 || x >= SCREEN_WIDTH || y < 0 || y >= SCREEN_HEIGHT) return;
-  int index = (y * SCREEN_WIDTH + x) / 2;
-  bool high = (x % 2 == 0);
-  uint8_t byte = static_cast<uint8_t>(buf[index]);
-  if (high) {
-    byte = (byte & 0x0F) | (value << 4);
-  } else {
-    byte = (byte & 0xF0) | (value & 0x0F);
-  }
-  buf[index] = static_cast<int8_t>(byte);
+  Epaper::set_pixel<Panel>(buf, x, y, static_cast<Panel::Color>(value));
 }
 
 Buffer draw_box(int margin, int width, uint8_t value) {
@@ -74,8 +66,7 @@ class EpaperDevice {
   }
 
   auto draw() -> void {
-    epd7in3e_.display(draw_box(20, 3, 0x01)
-                          .data()  // マージン10、幅20、色は白(0x0F)
+    epd7in3e_.display(draw_box(20, 3, 0x01)  // マージン10、幅20、色は白(0x0F)
     );
   }
 };
@@ -5,16 +5,14 @@
 
 #include <algorithm>
 #include <array>
-#include <cmath>
 #include <cstddef>
 #include <cstdint>
-#include <limits>
-#include <map>
 #include <memory>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
+#include "color_palette.hh"
 #include "image_server.grpc.pb.h"
 #define STB_IMAGE_IMPLEMENTATION // Define this before including stb_image.h
 #include "stb/stb_image.h" // stb_image.h must be available; IMPLEMENTATION macro should be defined once in a .cc
@@ -22,44 +20,11 @@
 
 namespace Apps::Common {
 
-// ------------------------------------------------------------------------------------------------
-//  Color palette for EPD (6‑color) displays
-// ------------------------------------------------------------------------------------------------
-
-enum class EPDColor : std::uint8_t {
-  BLACK = 0x00,
-  WHITE = 0x01,
-  YELLOW = 0x02,
-  RED = 0x03,
-  BLUE = 0x05,
-  GREEN = 0x06
-};
-
-using Color = std::array<std::uint8_t, 3>; // RGB triplet
-
-static const std::map<EPDColor, Color> PALETTE = {
-    {EPDColor::BLACK, {0, 0, 0}},      {EPDColor::WHITE, {255, 255, 255}},
-    {EPDColor::YELLOW, {255, 255, 0}}, {EPDColor::RED, {255, 0, 0}},
-    {EPDColor::BLUE, {0, 0, 255}},     {EPDColor::GREEN, {0, 255, 0}},
-};
-
 //---------------------------------------------------------------------
 //  Utility: find nearest palette color in Euclidean RGB space
 //---------------------------------------------------------------------
 [[nodiscard]] inline auto nearest_color(const Color &in) -> Color {
-  double min_dist = std::numeric_limits<double>::max();
-  Color best = {0, 0, 0};
-  for (const auto &[_, c] : PALETTE) {
-    double dist = 0.0;
-    for (int i = 0; i < 3; ++i) {
-      dist += std::pow(static_cast<int>(in[i]) - static_cast<int>(c[i]), 2);
-    }
-    if (dist < min_dist) {
-      min_dist = dist;
-      best = c;
-    }
-  }
-  return best;
+  return closest_palette_entry(in[0], in[1], in[2]).second;
 }
 
 //---------------------------------------------------------------------
@@ -101,22 +66,6 @@ inline void Atkinson(std::vector<std::uint8_t> &img, int w, int h) {
 constexpr int WIDTH = 800;
 constexpr int HEIGHT = 480;
 
-[[nodiscard]] inline EPDColor closest_epd_color(const std::uint8_t *rgb) {
-  double min_dist = std::numeric_limits<double>::max();
-  EPDColor closest = EPDColor::BLACK;
-  for (const auto &[color, val] : PALETTE) {
-    double dist = 0.0;
-    for (int i = 0; i < 3; ++i) {
-      dist += std::pow(rgb[i] - val[i], 2);
-    }
-    if (dist < min_dist) {
-      min_dist = dist;
-      closest = color;
-    }
-  }
-  return closest;
-}
-
 [[nodiscard]] inline auto encode_image(const std::string &path)
     -> std::vector<std::uint8_t> {
   int w, h, ch;
@@ -136,9 +85,8 @@ constexpr int HEIGHT = 480;
   if (w == WIDTH && h == HEIGHT) {
     // 正常な向き
     for (int i = 0; i < WIDTH * HEIGHT; i += 2) {
-      EPDColor c1 = closest_epd_color(&data[static_cast<ptrdiff_t>(i * 3)]);
-      EPDColor c2 =
-          closest_epd_color(&data[(static_cast<ptrdiff_t>(i + 1) * 3)]);
+      EPDColor c1 = closest_color(&data[static_cast<ptrdiff_t>(i * 3)]);
+      EPDColor c2 = closest_color(&data[(static_cast<ptrdiff_t>(i + 1) * 3)]);
       result.push_back((static_cast<std::uint8_t>(c2) & 0x0F) |
                        (static_cast<std::uint8_t>(c1) << 4));
     }
@@ -148,8 +96,8 @@ constexpr int HEIGHT = 480;
       for (int x = 0; x < WIDTH; x += 2) {
         int src_idx1 = (x * w + (h - 1 - y)) * 3;
         int src_idx2 = ((x + 1) * w + (h - 1 - y)) * 3;
-        EPDColor c1 = closest_epd_color(&data[src_idx1]);
-        EPDColor c2 = closest_epd_color(&data[src_idx2]);
+        EPDColor c1 = closest_color(&data[src_idx1]);
+        EPDColor c2 = closest_color(&data[src_idx2]);
         result.push_back((static_cast<std::uint8_t>(c2) & 0x0F) |
                          (static_cast<std::uint8_t>(c1) << 4));
       }
@@ -2,13 +2,15 @@
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <array>
-#include <cmath>
 #include <cstddef>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <string>
 #include <vector>
 
 #include "color_palette.hh"
+#include "frame_codec.hh"
 #include "image_server.grpc.pb.h"
 #include "stb/stb_image.h"
 
@@ -23,48 +25,47 @@ constexpr int WIDTH = 800;
 constexpr int HEIGHT = 480;
 
 using Apps::Common::EPDColor;
-using Apps::Common::PALETTE;
-
-auto closest_epd_color(const uint8_t *rgb) -> EPDColor {
-  double min_dist = std::numeric_limits<double>::max();
-  EPDColor closest = EPDColor::BLACK;
-  for (const auto &[color, val] : PALETTE) {
-    double dist = 0.0;
-    for (int i = 0; i < 3; ++i) {
-      dist += std::pow(rgb[i] - val[i], 2);
-    }
-    if (dist < min_dist) {
-      min_dist = dist;
-      closest = color;
-    }
-  }
-  return closest;
-}
 
-auto encode_image(const std::string &path) -> std::vector<uint8_t> {
+// An 800x480 image is packed here and sent BASE6_RLE-encoded when possible
+// (raw for other colours). Any other size goes as the file itself, which the
+// server fits and dithers.
+auto make_request(const std::string &path) -> DataRequest {
   int w, h, ch;
   uint8_t *data = stbi_load(path.c_str(), &w, &h, &ch, 3);
   if (!data) {
     throw std::runtime_error("Failed to load image: " + path);
   }
 
+  DataRequest request;
   if (w != WIDTH || h != HEIGHT) {
     stbi_image_free(data);
-    throw std::runtime_error("Expected 800x480 image");
+    std::ifstream file(path, std::ios::binary);
+    request.set_payload(std::string(std::istreambuf_iterator<char>(file), {}));
+    request.set_encoding(image_server::Encoding::IMAGE);
+    return request;
   }
 
-  std::vector<uint8_t> result;
-  result.reserve(WIDTH * HEIGHT / 2);
+  std::vector<uint8_t> packed;
+  packed.reserve(WIDTH * HEIGHT / 2);
 
   for (int i = 0; i < WIDTH * HEIGHT; i += 2) {
-    EPDColor c1 = closest_epd_color(&data[static_cast<ptrdiff_t>(i * 3)]);
-    EPDColor c2 = closest_epd_color(&data[static_cast<ptrdiff_t>((i + 1) * 3)]);
-    result.push_back((static_cast<uint8_t>(c2) & 0x0F) |
+    EPDColor c1 = Apps::Common::closest_color(
+        &data[static_cast<ptrdiff_t>(i * 3)]);
+    EPDColor c2 = Apps::Common::closest_color(
+        &data[static_cast<ptrdiff_t>((i + 1) * 3)]);
+    packed.push_back((static_cast<uint8_t>(c2) & 0x0F) |
                      (static_cast<uint8_t>(c1) << 4));
   }
-
   stbi_image_free(data);
-  return result;
+
+  // Cuts the Wi-Fi transfer several times over; other colours go raw.
+  if (auto encoded = Apps::Common::encode_base6_rle(packed)) {
+    request.set_payload(encoded->data(), encoded->size());
+    request.set_encoding(image_server::Encoding::BASE6_RLE);
+  } else {
+    request.set_payload(packed.data(), packed.size());
+  }
+  return request;
 }
 
 class ImageClient {
@@ -72,10 +73,7 @@ public:
   explicit ImageClient(std::shared_ptr<Channel> channel)
       : stub_(DataService::NewStub(channel)) {}
 
-  void Send(const std::vector<uint8_t> &payload) {
-    DataRequest request;
-    request.set_payload(payload.data(), payload.size());
-
+  void Send(const DataRequest &request) {
     DataResponse response;
     ClientContext context;
 
@@ -100,13 +98,14 @@ auto main(int argc, char *argv[]) -> int {
   }
 
   try {
-    std::vector<uint8_t> payload = encode_image(argv[1]);
+    DataRequest request = make_request(argv[1]);
 
     ImageClient client(grpc::CreateChannel("192.168.1.101:50051",
                                            grpc::InsecureChannelCredentials()));
 
-    std::cout << "Sending " << payload.size() << " bytes" << std::endl;
-    client.Send(payload);
+    std::cout << "Sending " << request.payload().size() << " bytes"
+              << std::endl;
+    client.Send(request);
 
   } catch (const std::exception &e) {
     std::cerr << "Fatal error: " << e.what() << std::endl;
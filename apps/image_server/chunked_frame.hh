@@ -0,0 +1,99 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// A frame arriving in row-aligned chunks. The network side appends rows in order while the panel
+// side reads each row as soon as it is in, so the SPI upload follows the network transfer instead
+// of waiting for the last byte.
+class ChunkedFrame {
+ public:
+  // Longest the panel is held for one frame, from the first row it reads to the last. A slower
+  // upload is abandoned rather than keeping every other frame off the panel.
+  static constexpr std::chrono::seconds READ_DEADLINE{5};
+
+  ChunkedFrame(size_t row_bytes, int height)
+      : row_bytes_(row_bytes), height_(height), buffer_(row_bytes * height) {}
+
+  // The whole frame, valid once complete().
+  [[nodiscard]] auto frame() const -> std::span<const uint8_t> { return buffer_; }
+
+  // Appends whole rows starting at `first_row`, which must be the first row not yet received.
+  // Returns false, leaving the frame unchanged, for anything else.
+  auto append(uint32_t first_row, std::string_view rows) -> bool {
+    std::lock_guard lock(mutex_);
+    const auto remaining = static_cast<size_t>(height_ - received_) * row_bytes_;
+    if (closed_ || first_row != static_cast<uint32_t>(received_) || rows.empty() ||
+        rows.size() % row_bytes_ != 0 || rows.size() > remaining) {
+      return false;
+    }
+    std::ranges::copy(rows, buffer_.begin() + static_cast<ptrdiff_t>(received_ * row_bytes_));
+    received_ += static_cast<int>(rows.size() / row_bytes_);
+    cv_.notify_all();
+    return true;
+  }
+
+  // No more rows will come; a reader waiting for a missing row fails.
+  void close() {
+    std::lock_guard lock(mutex_);
+    closed_ = true;
+    cv_.notify_all();
+  }
+
+  [[nodiscard]] auto complete() -> bool {
+    std::lock_guard lock(mutex_);
+    return received_ == height_;
+  }
+
+  // Whether the panel gave up on the frame at READ_DEADLINE.
+  [[nodiscard]] auto expired() -> bool {
+    std::lock_guard lock(mutex_);
+    return expired_;
+  }
+
+  // Copies row `row` into `out`, waiting for it to arrive. Throws if the upload ends first or
+  // misses READ_DEADLINE, which also closes the frame.
+  void read_row(int row, std::span<uint8_t> out) {
+    {
+      std::unique_lock lock(mutex_);
+      if (!deadline_) {
+        deadline_ = std::chrono::steady_clock::now() + READ_DEADLINE;
+      }
+      if (!cv_.wait_until(lock, *deadline_, [&] { return received_ > row || closed_; })) {
+        closed_ = true;
+        expired_ = true;
+        throw std::runtime_error("Upload too slow, " + std::to_string(received_) + " of " +
+                                 std::to_string(height_) + " rows in " +
+                                 std::to_string(READ_DEADLINE.count()) + " s");
+      }
+      if (received_ <= row) {
+        throw std::runtime_error("Upload ended after " + std::to_string(received_) + " of " +
+                                 std::to_string(height_) + " rows");
+      }
+    }
+    // Received rows never change again.
+    std::ranges::copy_n(buffer_.begin() + static_cast<ptrdiff_t>(row * row_bytes_),
+                        static_cast<ptrdiff_t>(row_bytes_), out.begin());
+  }
+
+ private:
+  const size_t row_bytes_;
+  const int height_;
+  std::vector<uint8_t> buffer_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  int received_ = 0;
+  bool closed_ = false;
+  bool expired_ = false;
+  std::optional<std::chrono::steady_clock::time_point> deadline_;  // set by the first read_row()
+};
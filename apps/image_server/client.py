@@ -2,8 +2,11 @@ import grpc
 import numpy as np
 from PIL import Image
 import sys
+import time
 
-from image_server_pb2 import DataRequest
+from image_server_pb2 import CachedRequest, DataRequest, Encoding, FrameChunk, WatchRequest
+from image_server_pb2 import Playlist, PlaylistEntry
+from image_server_pb2 import DisplayStage
 from image_server_pb2_grpc import DataServiceStub
 from image_server_pb2 import Status as DataStatus
 
@@ -32,11 +35,18 @@ def closest_epd_color(rgb: np.ndarray) -> int:
     return min(diffs, key=diffs.get)
 
 
+WIDTH = 800
+HEIGHT = 480
+ROW_BYTES = WIDTH // 2
+# Rows per UploadFrame chunk.
+CHUNK_ROWS = 24
+
+
 def encode_image(image_path: str) -> bytes:
     image = Image.open(image_path).convert("RGB")
     np_img = np.array(image)
 
-    if np_img.shape[:2] != (480, 800):
+    if np_img.shape[:2] != (HEIGHT, WIDTH):
         raise ValueError(
             f"Expected 480x800 image, got {np_img.shape[0]}x{np_img.shape[1]}"
         )
@@ -52,7 +62,77 @@ def encode_image(image_path: str) -> bytes:
     return bytes(encoded)
 
 
-def send_image_data(payload: bytes) -> None:
+# BASE6_RLE, as in apps/common/frame_codec.hh.
+BASE6_COLORS = [
+    EPDColor.BLACK,
+    EPDColor.WHITE,
+    EPDColor.YELLOW,
+    EPDColor.RED,
+    EPDColor.BLUE,
+    EPDColor.GREEN,
+]
+BASE6_RUN = 216
+BASE6_MIN_RUN = 6
+
+
+def encode_base6_rle(payload: bytes) -> bytes | None:
+    index = {color: i for i, color in enumerate(BASE6_COLORS)}
+    pixels = [nibble for byte in payload for nibble in (byte >> 4, byte & 0x0F)]
+    if any(p not in index for p in pixels):
+        return None
+
+    out = bytearray()
+    literal: list[int] = []
+
+    def push_literal(i: int) -> None:
+        literal.append(i)
+        if len(literal) == 3:
+            out.append(literal[0] * 36 + literal[1] * 6 + literal[2])
+            literal.clear()
+
+    i = 0
+    while i < len(pixels):
+        run = 1
+        while i + run < len(pixels) and pixels[i + run] == pixels[i]:
+            run += 1
+        color = index[pixels[i]]
+        to_fill = (3 - len(literal)) % 3
+        if run < BASE6_MIN_RUN + to_fill:
+            push_literal(color)
+            i += 1
+            continue
+        for _ in range(to_fill):
+            push_literal(color)
+        i += run
+        run -= to_fill
+        out.append(BASE6_RUN + color)
+        extra = run - BASE6_MIN_RUN
+        while extra >= 0x80:
+            out.append((extra & 0x7F) | 0x80)
+            extra >>= 7
+        out.append(extra)
+    while literal:
+        push_literal(0)
+    return bytes(out)
+
+
+def frame_chunks(payload: bytes, priority: int, ttl_ms: int):
+    for row in range(0, HEIGHT, CHUNK_ROWS):
+        rows = payload[row * ROW_BYTES : (row + CHUNK_ROWS) * ROW_BYTES]
+        if row == 0:
+            yield FrameChunk(first_row=row, rows=rows, priority=priority, ttl_ms=ttl_ms)
+        else:
+            yield FrameChunk(first_row=row, rows=rows)
+
+
+def send_image_data(
+    payload: bytes,
+    priority: int = 0,
+    ttl_ms: int = 0,
+    chunked: bool = False,
+    render: bool = False,
+    visible_at_us: int = 0,
+) -> None:
     with grpc.insecure_channel(
         "192.168.1.101:50051",
         options=[("grpc.primary_user_agent", "ipv4-client")],
@@ -68,20 +148,128 @@ def send_image_data(payload: bytes) -> None:
         stub = DataServiceStub(channel)
 
         print(f"Sending {len(payload)} bytes")
-        request = DataRequest(payload=payload)
-        response = stub.SendData(request)
+        if chunked:
+            # The server starts the panel upload while the chunks are still arriving.
+            response = stub.UploadFrame(frame_chunks(payload, priority, ttl_ms))
+            print("Received status:", DataStatus.Name(response.status))
+            print(f"Waited {response.wait_ms} ms behind {response.queue_depth} queued frames")
+            return
+
+        request = DataRequest(
+            payload=payload, priority=priority, ttl_ms=ttl_ms, visible_at_us=visible_at_us
+        )
+        if render:
+            # The server decodes, fits and dithers the file itself.
+            request.encoding = Encoding.IMAGE
+        elif (encoded := encode_base6_rle(payload)) is not None:
+            print(f"Encoded to {len(encoded)} bytes")
+            request.payload = encoded
+            request.encoding = Encoding.BASE6_RLE
+        response = stub.SubmitData(request)
+        if response.status != DataStatus.OK:
+            print("Rejected:", DataStatus.Name(response.status))
+            return
+        print(f"Queued as ticket {response.ticket}")
+
+        # The stream ends after the DONE event.
+        start_us = None
+        for event in stub.WatchDisplay(WatchRequest(ticket=response.ticket)):
+            start_us = start_us if start_us is not None else event.timestamp_us
+            elapsed_ms = (event.timestamp_us - start_us) / 1000
+            print(f"{elapsed_ms:8.1f} ms  {DisplayStage.Name(event.stage)}")
+            if event.stage == DisplayStage.DONE:
+                print("Received status:", DataStatus.Name(event.status))
+                print(f"Waited {event.wait_ms} ms in the queue")
+                if event.frame_id:
+                    print(f"Shown as frame {event.frame_id:016x}")
+
+
+def display_cached(
+    frame_id: int, priority: int = 0, ttl_ms: int = 0, visible_at_us: int = 0
+) -> None:
+    with grpc.insecure_channel(
+        "192.168.1.101:50051",
+        options=[("grpc.primary_user_agent", "ipv4-client")],
+        compression=None,
+    ) as channel:
+        stub = DataServiceStub(channel)
+        response = stub.DisplayCached(
+            CachedRequest(
+                frame_id=frame_id, priority=priority, ttl_ms=ttl_ms, visible_at_us=visible_at_us
+            )
+        )
+        print("Received status:", DataStatus.Name(response.status))
+        if response.status == DataStatus.NOT_CACHED:
+            print("Send the image again instead")
+
 
+def set_playlist(image_paths: list[str], duration_s: int, shuffle: bool = False) -> None:
+    entries = []
+    for path in image_paths:
+        with open(path, "rb") as f:
+            # The server renders each image ahead of its turn.
+            image = DataRequest(payload=f.read(), encoding=Encoding.IMAGE)
+        entries.append(PlaylistEntry(image=image, duration_s=duration_s))
+
+    with grpc.insecure_channel(
+        "192.168.1.101:50051",
+        options=[("grpc.primary_user_agent", "ipv4-client"), ("grpc.max_send_message_length", -1)],
+        compression=None,
+    ) as channel:
+        stub = DataServiceStub(channel)
+        response = stub.SetPlaylist(Playlist(entries=entries, shuffle=shuffle))
         print("Received status:", DataStatus.Name(response.status))
+        if response.status != DataStatus.OK:
+            print("Problem with", image_paths[response.entry])
+
+
+def next_minute_us() -> int:
+    # Far enough ahead for the server to start the refresh in time.
+    return (int(time.time()) // 60 + 2) * 60_000_000
 
 
 def main() -> None:
-    if len(sys.argv) != 2:
-        print(f"Usage: {sys.argv[0]} /path/to/image.bmp")
+    if sys.argv[1:2] == ["--playlist"]:
+        shuffle = "--shuffle" in sys.argv[2:]
+        args = [arg for arg in sys.argv[2:] if arg != "--shuffle"]
+        if len(args) < 1:
+            print(f"Usage: {sys.argv[0]} --playlist [--shuffle] duration_s [image ...]")
+            sys.exit(1)
+        # No images stops the slideshow.
+        set_playlist(args[1:], int(args[0]), shuffle)
+        return
+
+    flags = {"--chunked", "--render", "--cached", "--on-minute"}
+    chunked = "--chunked" in sys.argv[1:]
+    render = "--render" in sys.argv[1:]
+    cached = "--cached" in sys.argv[1:]
+    # Finish the refresh on a minute boundary, as a clock would.
+    visible_at_us = next_minute_us() if "--on-minute" in sys.argv[1:] else 0
+    args = [arg for arg in sys.argv[1:] if arg not in flags]
+    if len(args) not in (1, 2, 3) or chunked + render + cached > 1 or (chunked and visible_at_us):
+        print(
+            f"Usage: {sys.argv[0]} [--chunked | --render] [--on-minute] /path/to/image.bmp"
+            " [priority] [ttl_ms]\n"
+            f"       {sys.argv[0]} --cached [--on-minute] frame_id [priority] [ttl_ms]\n"
+            f"       {sys.argv[0]} --playlist [--shuffle] duration_s [image ...]"
+        )
         sys.exit(1)
 
-    image_path = sys.argv[1]
-    payload = encode_image(image_path)
-    send_image_data(payload)
+    priority = int(args[1]) if len(args) > 1 else 0
+    ttl_ms = int(args[2]) if len(args) > 2 else 0
+    if cached:
+        # The ID printed when the frame was last shown.
+        display_cached(int(args[0], 16), priority, ttl_ms, visible_at_us)
+        return
+
+    image_path = args[0]
+    if render:
+        # Any size or format the server can decode.
+        with open(image_path, "rb") as f:
+            payload = f.read()
+    else:
+        payload = encode_image(image_path)
+    send_image_data(payload, priority, ttl_ms, chunked, render, visible_at_us)
 
 
 if __name__ == "__main__":
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <bitset>
+#include <charconv>
+#include <chrono>
+#include <ctime>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+// The minutes matched by a crontab time spec, "minute hour day-of-month month day-of-week", in
+// local time. Each field is `*` or a comma-separated list of values and ranges, optionally with a
+// `/step`; Sunday is 0 or 7. As in cron, when both day fields are restricted a day matching
+// either one matches.
+class CronWindow {
+ public:
+  // Every minute, for an empty spec; nothing if `text` is not a valid spec.
+  static auto parse(std::string_view text) -> std::optional<CronWindow> {
+    CronWindow window;
+    if (text.find_first_not_of(' ') == std::string_view::npos) {
+      text = "* * * * *";
+    }
+    std::bitset<FIELD_BITS> days;
+    std::bitset<FIELD_BITS> weekdays;
+    // Unrestricted day fields are the ones that start with `*`, as in cron.
+    bool any_day = false;
+    bool any_weekday = false;
+    for (int field = 0; field < 5; ++field) {
+      const auto start = text.find_first_not_of(' ');
+      if (start == std::string_view::npos) {
+        return std::nullopt;
+      }
+      text.remove_prefix(start);
+      const auto token = text.substr(0, text.find(' '));
+      text.remove_prefix(token.size());
+
+      std::bitset<FIELD_BITS> bits;
+      if (!parse_field_(token, LIMITS[field].first, LIMITS[field].second, bits)) {
+        return std::nullopt;
+      }
+      switch (field) {
+        case 0:
+          window.minutes_ = bits;
+          break;
+        case 1:
+          window.hours_ = bits;
+          break;
+        case 2:
+          days = bits;
+          any_day = token.starts_with('*');
+          break;
+        case 3:
+          window.months_ = bits;
+          break;
+        case 4:
+          weekdays = bits;
+          weekdays[0] = weekdays[0] || weekdays[7];
+          any_weekday = token.starts_with('*');
+          break;
+      }
+    }
+    if (text.find_first_not_of(' ') != std::string_view::npos) {
+      return std::nullopt;
+    }
+
+    window.days_ = days;
+    window.weekdays_ = weekdays;
+    window.either_day_ = !any_day && !any_weekday;
+    return window;
+  }
+
+  [[nodiscard]] auto contains(std::chrono::system_clock::time_point time) const -> bool {
+    const std::time_t seconds = std::chrono::system_clock::to_time_t(time);
+    std::tm local{};
+    localtime_r(&seconds, &local);
+    if (!minutes_[local.tm_min] || !hours_[local.tm_hour] || !months_[local.tm_mon + 1]) {
+      return false;
+    }
+    const bool day = days_[local.tm_mday];
+    const bool weekday = weekdays_[local.tm_wday];
+    return either_day_ ? day || weekday : day && weekday;
+  }
+
+ private:
+  static constexpr size_t FIELD_BITS = 60;
+  static constexpr std::pair<int, int> LIMITS[] = {{0, 59}, {0, 23}, {1, 31}, {1, 12}, {0, 7}};
+
+  // One field into `bits`, where bit N is value N.
+  static auto parse_field_(std::string_view token, int low, int high,
+                           std::bitset<FIELD_BITS>& bits) -> bool {
+    while (!token.empty()) {
+      const auto comma = token.find(',');
+      auto item = token.substr(0, comma);
+      token.remove_prefix(comma == std::string_view::npos ? token.size() : comma + 1);
+      if (item.empty()) {
+        return false;
+      }
+
+      int step = 1;
+      if (const auto slash = item.find('/'); slash != std::string_view::npos) {
+        if (!parse_number_(item.substr(slash + 1), step) || step <= 0) {
+          return false;
+        }
+        item = item.substr(0, slash);
+      }
+      int first = low;
+      int last = high;
+      if (item != "*") {
+        const auto dash = item.find('-');
+        if (!parse_number_(item.substr(0, dash), first)) {
+          return false;
+        }
+        last = first;
+        if (dash != std::string_view::npos && !parse_number_(item.substr(dash + 1), last)) {
+          return false;
+        }
+      }
+      if (first < low || last > high || first > last) {
+        return false;
+      }
+      for (int value = first; value <= last; value += step) {
+        bits.set(static_cast<size_t>(value));
+      }
+    }
+    return bits.any();
+  }
+
+  static auto parse_number_(std::string_view text, int& value) -> bool {
+    const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc{} && end == text.data() + text.size();
+  }
+
+  std::bitset<FIELD_BITS> minutes_;
+  std::bitset<FIELD_BITS> hours_;
+  std::bitset<FIELD_BITS> days_;
+  std::bitset<FIELD_BITS> months_;
+  std::bitset<FIELD_BITS> weekdays_;
+  bool either_day_ = false;
+};
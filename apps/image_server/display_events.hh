@@ -0,0 +1,99 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+// Fan-out of per-ticket progress events to any number of watchers. The events of the most recent
+// tickets are kept, so a client that starts watching right after submitting still sees the whole
+// sequence. `Event` needs a `ticket` member.
+template <typename Event>
+class EventHub {
+ public:
+  // Both run with the hub locked: they must not subscribe or unsubscribe.
+  using Listener = std::function<void(const Event&)>;
+  using CloseListener = std::function<void()>;
+
+  static constexpr size_t HISTORY_TICKETS = 64;
+
+  // Delivers the events of `ticket`, starting with those already published, or the live events
+  // of every ticket when `ticket` is 0. Returns nothing when `ticket` is unknown (never issued or
+  // too old), or when the hub is already closed, in which case `on_close` has run.
+  auto subscribe(uint64_t ticket, Listener on_event, CloseListener on_close)
+      -> std::optional<uint64_t> {
+    std::lock_guard lock(mutex_);
+    if (closed_) {
+      on_close();
+      return std::nullopt;
+    }
+    if (ticket != 0) {
+      auto history = find_(ticket);
+      if (history == history_.end()) {
+        return std::nullopt;
+      }
+      for (const auto& event : history->second) {
+        on_event(event);
+      }
+    }
+    const auto id = next_id_++;
+    subscribers_.emplace(id, Subscriber{ticket, std::move(on_event), std::move(on_close)});
+    return id;
+  }
+
+  // No listener of `id` runs after this returns.
+  void unsubscribe(uint64_t id) {
+    std::lock_guard lock(mutex_);
+    subscribers_.erase(id);
+  }
+
+  void publish(const Event& event) {
+    std::lock_guard lock(mutex_);
+    auto history = find_(event.ticket);
+    if (history == history_.end()) {
+      if (history_.size() == HISTORY_TICKETS) {
+        history_.pop_front();
+      }
+      history = history_.insert(history_.end(), {event.ticket, {}});
+    }
+    history->second.push_back(event);
+
+    for (const auto& [id, subscriber] : subscribers_) {
+      if (subscriber.ticket == 0 || subscriber.ticket == event.ticket) {
+        subscriber.on_event(event);
+      }
+    }
+  }
+
+  // Ends every subscription, e.g. on shutdown.
+  void close() {
+    std::lock_guard lock(mutex_);
+    closed_ = true;
+    for (const auto& [id, subscriber] : subscribers_) {
+      subscriber.on_close();
+    }
+    subscribers_.clear();
+  }
+
+ private:
+  struct Subscriber {
+    uint64_t ticket;
+    Listener on_event;
+    CloseListener on_close;
+  };
+
+  auto find_(uint64_t ticket) {
+    return std::ranges::find(history_, ticket, &std::pair<uint64_t, std::vector<Event>>::first);
+  }
+
+  std::mutex mutex_;
+  std::deque<std::pair<uint64_t, std::vector<Event>>> history_;
+  std::map<uint64_t, Subscriber> subscribers_;
+  uint64_t next_id_ = 1;
+  bool closed_ = false;
+};
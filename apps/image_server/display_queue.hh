@@ -0,0 +1,670 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <stop_token>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "display_events.hh"
+#include "epd_driver.hh"
+#include "epd_frame_hash.hh"
+#include "frame_cache.hh"
+#include "frame_queue.hh"
+#include "last_frame.hh"
+
+inline auto to_ms(std::chrono::nanoseconds duration) -> double {
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+// One line per phase of the last call, followed by the running counters.
+inline void print_timings(const Epaper::DisplayResult& result,
+                          const std::array<Epaper::PhaseStats, Epaper::PHASE_COUNT>& stats) {
+  std::cout << std::fixed << std::setprecision(1);
+  for (const auto& phase : result.report.phases) {
+    std::cout << "  " << std::setw(14) << std::left << Epaper::to_string(phase.phase) << std::right
+              << std::setw(10) << to_ms(phase.duration) << " ms" << std::endl;
+  }
+  std::cout << "  phase            count     min ms     avg ms     max ms     p99 ms" << std::endl;
+  for (size_t i = 0; i < stats.size(); ++i) {
+    const auto& s = stats[i];
+    if (s.count == 0) {
+      continue;
+    }
+    std::cout << "  " << std::setw(14) << std::left
+              << Epaper::to_string(static_cast<Epaper::Phase>(i)) << std::right << std::setw(8)
+              << s.count << std::setw(11) << to_ms(s.min) << std::setw(11) << to_ms(s.avg)
+              << std::setw(11) << to_ms(s.max) << std::setw(11) << to_ms(s.p99) << std::endl;
+  }
+}
+
+// When a frame with a target reached the glass, against that target.
+inline void print_target(const Epaper::CallReport& report,
+                         std::chrono::steady_clock::time_point target) {
+  for (const auto& phase : report.phases) {
+    if (phase.phase == Epaper::Phase::REFRESH) {
+      std::cout << "Visible " << std::showpos << to_ms(phase.start + phase.duration - target)
+                << std::noshowpos << " ms from its target" << std::endl;
+    }
+  }
+}
+
+enum class FrameOutcome : uint8_t {
+  DISPLAYED,  // refreshed onto the glass
+  SKIPPED,    // already on the glass
+  SUPERSEDED, // replaced by a newer frame of the same priority and kind, or evicted by a higher one
+  EXPIRED,    // its TTL ran out while it waited
+  QUEUE_FULL, // every queue slot held a frame of higher or equal priority
+  FAILED,     // the panel failed or the server is shutting down; see `error`
+};
+
+struct FrameResult {
+  FrameOutcome outcome = FrameOutcome::FAILED;
+  Epaper::CallReport report;          // phases of the refresh, when the frame reached the panel
+  std::chrono::nanoseconds waited{};  // submission until the panel took it or it was dropped
+  size_t queue_depth = 0;             // frames already waiting when this one arrived
+  uint64_t frame_id = 0;              // ID of the frame on the glass, when DISPLAYED or SKIPPED
+  std::exception_ptr error;
+};
+
+enum class DisplayStage : uint8_t {
+  QUEUED,      // accepted and waiting for the panel
+  UPLOADING,   // frame going to panel RAM
+  REFRESHING,  // panel refreshing the glass
+  DONE,        // finished one way or another; see `result`
+};
+
+struct DisplayEvent {
+  uint64_t ticket = 0;
+  DisplayStage stage = DisplayStage::QUEUED;
+  std::chrono::system_clock::time_point time;
+  FrameResult result;  // DONE only
+};
+
+// Hand-off from the RPC layer to the panel. Frames wait in a bounded priority queue and go to the
+// driver's worker one at a time, so the frame refreshed next is always the most urgent one still
+// valid. Nothing can interrupt a refresh in progress, so an urgent frame waits at most one refresh.
+class DisplayQueue {
+ public:
+  using Completion = std::function<void(const FrameResult&)>;
+  using VisibleAt = std::optional<std::chrono::system_clock::time_point>;
+  using Panel = Epaper::Panel7in3e;
+  using Driver = Epaper::EPDDriver<Panel>;
+
+  static constexpr size_t CAPACITY = 8;
+  // Threads reading frames with a target ahead of time. A stalled producer holds one until it gives
+  // up, which for UploadFrame is ChunkedFrame::READ_DEADLINE.
+  static constexpr size_t PREPARERS = 2;
+  // Time to the glass assumed until a refresh has been measured; the 7.3" panel takes about this.
+  static constexpr std::chrono::seconds UNMEASURED_REFRESH{20};
+
+  // Panel bring-up (reset, init table, BUSY waits) runs in the background so the server can bind
+  // and accept requests immediately; frames queue up until it finishes.
+  // Frames that reach the glass are added to `cache`, which must outlive the queue.
+  DisplayQueue(LastFrameStore last_frame, FrameCache& cache)
+      : last_frame_(std::move(last_frame)),
+        cache_(cache),
+        queue_(CAPACITY),
+        init_([this] { init_panel_(); }),
+        timer_([this](std::stop_token stop) { run_timer_(stop); }) {
+    for (auto& preparer : preparers_) {
+      preparer = std::jthread([this](std::stop_token stop) { run_preparer_(stop); });
+    }
+    persister_ = std::jthread([this](std::stop_token stop) { run_persister_(stop); });
+  }
+
+  ~DisplayQueue() { shutdown(); }
+
+  DisplayQueue(const DisplayQueue&) = delete;
+  auto operator=(const DisplayQueue&) -> DisplayQueue& = delete;
+
+  // Queues `frame`, which `owner` keeps alive. Higher `priority` goes first; a zero `ttl` never
+  // expires. With `visible_at`, the frame is held back so that, going by the measured phase
+  // timings, its refresh ends then. `done` runs exactly once, on the driver's worker or on a
+  // submitting thread. Returns the ticket under which the frame's progress is published on
+  // events().
+  auto submit(std::span<const uint8_t> frame, std::shared_ptr<const void> owner, uint32_t priority,
+              std::chrono::milliseconds ttl, VisibleAt visible_at, Completion done) -> uint64_t {
+    return submit_({frame, std::move(owner), {}, std::move(done), 0, 0, {}, {}}, priority, ttl,
+                   visible_at);
+  }
+
+  // Like submit(), for a frame still arriving: the panel pulls its rows from `producer`, which
+  // may block until they come in, and `frame` holds the whole frame by the time it completes. A
+  // frame with `visible_at` is read in full while it waits, so its upload runs from memory.
+  auto submit_stream(std::span<const uint8_t> frame, std::shared_ptr<const void> owner,
+                     Epaper::RowProducer producer, uint32_t priority, std::chrono::milliseconds ttl,
+                     VisibleAt visible_at, Completion done) -> uint64_t {
+    return submit_({frame, std::move(owner), std::move(producer), std::move(done), 0, 0, {}, {}},
+                   priority, ttl, visible_at);
+  }
+
+  // Copies the frame on the glass into `out` if its ID is `id`, as the base of a delta frame.
+  // Returns false for any other ID, e.g. when a newer frame has been displayed since.
+  auto copy_displayed(uint64_t id, std::span<uint8_t> out) -> bool {
+    std::lock_guard lock(mutex_);
+    if (!displayed_id_ || *displayed_id_ != id || out.size() != displayed_.size()) {
+      return false;
+    }
+    std::ranges::copy(displayed_, out.begin());
+    return true;
+  }
+
+  // Progress of every submitted frame, by ticket.
+  auto events() -> EventHub<DisplayEvent>& { return events_; }
+
+  // Stops taking frames and shuts the panel down. Queued frames fail, a refresh in progress runs to
+  // completion, so every submitted frame has completed on return; then the event streams end.
+  void shutdown() {
+    if (init_.joinable()) {
+      init_.join();
+    }
+    stop_preparers_();
+    timer_.request_stop();
+    if (timer_.joinable()) {
+      timer_.join();
+    }
+    std::unique_ptr<Driver> epd;
+    std::vector<Queue::Entry> queued;
+    {
+      std::lock_guard lock(mutex_);
+      closed_ = true;
+      queued = queue_.take_all();
+      epd = std::move(epd_);
+    }
+    const auto error = std::make_exception_ptr(std::runtime_error("Server is shutting down"));
+    for (auto& entry : queued) {
+      complete_(entry.item, {.outcome = FrameOutcome::FAILED, .error = error});
+    }
+    epd.reset();
+    persister_.request_stop();
+    if (persister_.joinable()) {
+      persister_.join();
+    }
+    events_.close();
+  }
+
+ private:
+  struct Pending {
+    std::span<const uint8_t> frame;
+    std::shared_ptr<const void> owner;
+    Epaper::RowProducer producer;  // set for frames still arriving
+    Completion done;
+    size_t queue_depth;
+    uint64_t ticket;
+    std::optional<std::chrono::steady_clock::time_point> visible_at;
+    std::shared_future<void> prepared;  // the producer read in full, for frames with a target
+  };
+  using Queue = FrameQueue<Pending>;
+
+  // A frame that reached the glass, waiting to be written to disk.
+  struct Persist {
+    std::span<const uint8_t> frame;
+    std::shared_ptr<const void> owner;  // keeps `frame` alive
+    uint64_t id;
+    bool on_glass;
+  };
+
+  // A frame with a target waiting for a preparer.
+  struct Preparation {
+    Epaper::RowProducer producer;
+    std::promise<void> prepared;
+  };
+
+  // How long a frame takes from the driver to the glass, and until the panel is free again.
+  struct Estimate {
+    std::chrono::nanoseconds visible{};
+    std::chrono::nanoseconds total{};
+  };
+
+  auto submit_(Pending pending, uint32_t priority, std::chrono::milliseconds ttl,
+               VisibleAt visible_at) -> uint64_t {
+    const auto now = Queue::Clock::now();
+    if (visible_at) {
+      pending.visible_at = now + (*visible_at - std::chrono::system_clock::now());
+      if (pending.producer) {
+        pending.prepared = prepare_(pending.producer);
+      }
+    }
+    Queue::Entry entry{
+        .priority = priority,
+        .submitted = now,
+        .expires = ttl > std::chrono::milliseconds::zero() ? std::optional(now + ttl)
+                                                          : std::nullopt,
+        .start = std::nullopt,
+        .item = std::move(pending),
+    };
+
+    std::vector<Queue::Entry> superseded;
+    std::vector<Queue::Entry> expired;
+    std::optional<Queue::Entry> rejected;
+    std::exception_ptr error;
+    uint64_t ticket = 0;
+    {
+      std::lock_guard lock(mutex_);
+      // Published under the lock so QUEUED always precedes the frame's other events.
+      ticket = entry.item.ticket = next_ticket_++;
+      publish_(ticket, DisplayStage::QUEUED);
+      if (closed_) {
+        error = std::make_exception_ptr(std::runtime_error("Server is shutting down"));
+      } else if (init_error_) {
+        error = init_error_;
+      } else {
+        if (entry.item.visible_at) {
+          entry.start = *entry.item.visible_at - estimate_locked_().visible;
+          timer_changed_ = true;
+        }
+        expired = queue_.take_expired(now);
+        entry.item.queue_depth = queue_.size();
+        rejected = queue_.push(std::move(entry), superseded);
+        dispatch_locked_(expired);
+      }
+    }
+    timer_cv_.notify_one();
+
+    if (error) {
+      complete_(entry.item, {.outcome = FrameOutcome::FAILED, .error = error});
+    }
+    if (rejected) {
+      drop_(*rejected, FrameOutcome::QUEUE_FULL, now);
+    }
+    for (auto& dropped : superseded) {
+      drop_(dropped, FrameOutcome::SUPERSEDED, now);
+    }
+    drop_expired_(expired);
+    return ticket;
+  }
+
+  void init_panel_() {
+    std::unique_ptr<Driver> epd;
+    try {
+      const auto start = std::chrono::steady_clock::now();
+      epd = std::make_unique<Driver>();
+      // Keep the image on exit; the next start picks it up from last_frame_.
+      epd->set_shutdown_policy(Epaper::ShutdownPolicy::SLEEP);
+      epd->set_power_policy(power_policy_from_environment_());
+      epd->set_phase_observer([this](Epaper::Operation operation, Epaper::Phase phase) {
+        observe_phase_(operation, phase);
+      });
+      if (auto frame = last_frame_.load(Driver::FRAME_BYTES)) {
+        const auto id = Epaper::frame_hash(*frame);
+        epd->set_displayed_hash(id);
+        remember_displayed_(*frame, id);
+        std::cout << "Restored last displayed frame" << std::endl;
+      }
+      std::cout << "e-Paper ready after " << to_ms(std::chrono::steady_clock::now() - start)
+                << " ms" << std::endl;
+    } catch (const std::exception& e) {
+      std::cerr << "e-Paper init failed: " << e.what() << std::endl;
+      std::vector<Queue::Entry> queued;
+      {
+        std::lock_guard lock(mutex_);
+        init_error_ = std::current_exception();
+        queued = queue_.take_all();
+      }
+      for (auto& entry : queued) {
+        complete_(entry.item, {.outcome = FrameOutcome::FAILED, .error = std::current_exception()});
+      }
+      return;
+    }
+
+    std::vector<Queue::Entry> expired;
+    {
+      std::lock_guard lock(mutex_);
+      epd_ = std::move(epd);
+      dispatch_locked_(expired);
+    }
+    drop_expired_(expired);
+  }
+
+  // Has a frame that reached the glass written to the cache, and to `last_frame_` if `on_glass`, by
+  // the persister, which keeps the file writes off the driver's worker, so it lands in the cache
+  // shortly after it completes. A frame already cached is only marked as used.
+  void persist_(std::span<const uint8_t> frame, std::shared_ptr<const void> owner, uint64_t id,
+                bool on_glass) {
+    if (!on_glass && cache_.touch(id)) {
+      return;
+    }
+    {
+      std::lock_guard lock(persist_mutex_);
+      persists_.push_back({frame, std::move(owner), id, on_glass});
+    }
+    persist_cv_.notify_one();
+  }
+
+  // Writes the frames handed to persist_() in order. On stop, it finishes the ones still waiting
+  // first, so the frame last shown is on disk when the server exits.
+  void run_persister_(const std::stop_token& stop) {
+    std::unique_lock lock(persist_mutex_);
+    while (persist_cv_.wait(lock, stop, [this] { return !persists_.empty(); })) {
+      auto persist = std::move(persists_.front());
+      persists_.pop_front();
+      lock.unlock();
+      if (persist.on_glass) {
+        last_frame_.store(persist.frame);
+      }
+      cache_.store(persist.frame, persist.id);
+      lock.lock();
+    }
+  }
+
+  // Panel power between frames: IMAGE_SERVER_POWER_HOLD_MS keeps the booster on that long after a
+  // refresh (default 0, off right away), then IMAGE_SERVER_IDLE_ACTION applies, "power_off" (the
+  // default) or "deep_sleep".
+  static auto power_policy_from_environment_() -> Epaper::PowerPolicy {
+    Epaper::PowerPolicy policy;
+    if (const char* hold = std::getenv("IMAGE_SERVER_POWER_HOLD_MS")) {
+      policy.hold = std::chrono::milliseconds(std::strtoull(hold, nullptr, 10));
+    }
+    if (const char* action = std::getenv("IMAGE_SERVER_IDLE_ACTION")) {
+      const std::string_view name = action;
+      if (name == "deep_sleep") {
+        policy.idle_action = Epaper::IdleAction::DEEP_SLEEP;
+      } else if (name != "power_off") {
+        std::cerr << "Ignoring unknown IMAGE_SERVER_IDLE_ACTION " << name << std::endl;
+      }
+    }
+    return policy;
+  }
+
+  // Has every row of a frame with a target read ahead of time by a preparer.
+  auto prepare_(Epaper::RowProducer producer) -> std::shared_future<void> {
+    std::promise<void> promise;
+    auto prepared = promise.get_future().share();
+    {
+      std::lock_guard lock(prepare_mutex_);
+      preparations_.push_back({std::move(producer), std::move(promise)});
+    }
+    prepare_cv_.notify_one();
+    return prepared;
+  }
+
+  // Runs the preparations in turn. One whose frame has been dropped meanwhile still runs; the
+  // producer it holds keeps the frame alive until then.
+  void run_preparer_(const std::stop_token& stop) {
+    std::vector<uint8_t> row(Panel::ROW_BYTES);
+    std::unique_lock lock(prepare_mutex_);
+    while (prepare_cv_.wait(lock, stop, [this] { return !preparations_.empty(); })) {
+      auto preparation = std::move(preparations_.front());
+      preparations_.pop_front();
+      lock.unlock();
+      try {
+        for (int y = 0; y < Panel::HEIGHT; ++y) {
+          if (!preparation.producer(y, row)) {
+            throw std::runtime_error("Frame was cancelled");
+          }
+        }
+        preparation.prepared.set_value();
+      } catch (...) {
+        preparation.prepared.set_exception(std::current_exception());
+      }
+      lock.lock();
+    }
+  }
+
+  // Fails the preparations not yet started and waits for the ones running, so no frame in the
+  // driver is left waiting on a preparer.
+  void stop_preparers_() {
+    std::deque<Preparation> unstarted;
+    {
+      std::lock_guard lock(prepare_mutex_);
+      unstarted = std::exchange(preparations_, {});
+      for (auto& preparer : preparers_) {
+        preparer.request_stop();
+      }
+    }
+    const auto error = std::make_exception_ptr(std::runtime_error("Server is shutting down"));
+    for (auto& preparation : unstarted) {
+      preparation.prepared.set_exception(error);
+    }
+    for (auto& preparer : preparers_) {
+      if (preparer.joinable()) {
+        preparer.join();
+      }
+    }
+  }
+
+  // From the average duration of each phase the last refresh went through, which tracks the
+  // panel's power state too.
+  [[nodiscard]] auto estimate_locked_() const -> Estimate {
+    if (epd_ == nullptr || display_phases_.empty()) {
+      return {UNMEASURED_REFRESH, UNMEASURED_REFRESH};
+    }
+    const auto stats = epd_->phase_stats();
+    Estimate estimate;
+    bool refreshed = false;
+    for (const auto phase : display_phases_) {
+      const auto average = stats[static_cast<size_t>(phase)].avg;
+      estimate.total += average;
+      if (!refreshed) {
+        estimate.visible += average;
+      }
+      refreshed = refreshed || phase == Epaper::Phase::REFRESH;
+    }
+    return estimate;
+  }
+
+  // Dispatches held frames when they become due, since no submission or completion may come
+  // along then.
+  void run_timer_(const std::stop_token& stop) {
+    std::unique_lock lock(mutex_);
+    while (!stop.stop_requested()) {
+      std::vector<Queue::Entry> expired;
+      dispatch_locked_(expired);
+      if (!expired.empty()) {
+        lock.unlock();
+        drop_expired_(expired);
+        lock.lock();
+        continue;
+      }
+      const auto changed = [this] { return std::exchange(timer_changed_, false); };
+      if (const auto next = queue_.next_start(Queue::Clock::now())) {
+        timer_cv_.wait_until(lock, stop, *next, changed);
+      } else {
+        timer_cv_.wait(lock, stop, changed);
+      }
+    }
+  }
+
+  // Hands the next frame to an idle panel, setting aside expired ones for the caller to complete
+  // outside the lock. Holding the lock keeps shutdown() from destroying the driver meanwhile. The
+  // driver completes a frame from inside display_async() only when the new one supersedes it, and
+  // busy_ never lets a second frame reach it, so this cannot re-enter.
+  void dispatch_locked_(std::vector<Queue::Entry>& expired) {
+    if (epd_ == nullptr || busy_ || closed_) {
+      return;
+    }
+    auto more = queue_.take_expired(Queue::Clock::now());
+    std::ranges::move(more, std::back_inserter(expired));
+    if (auto next = queue_.pop(Queue::Clock::now(), estimate_locked_().total)) {
+      busy_ = true;
+      start_locked_(std::move(*next));
+    }
+  }
+
+  void drop_expired_(std::vector<Queue::Entry>& expired) {
+    const auto now = Queue::Clock::now();
+    for (auto& dropped : expired) {
+      drop_(dropped, FrameOutcome::EXPIRED, now);
+    }
+  }
+
+  void drop_(Queue::Entry& entry, FrameOutcome outcome, Queue::Clock::time_point now) {
+    complete_(entry.item, {.outcome = outcome,
+                           .waited = now - entry.submitted,
+                           .queue_depth = entry.item.queue_depth});
+  }
+
+  void remember_displayed_(std::span<const uint8_t> frame, uint64_t id) {
+    std::lock_guard lock(mutex_);
+    displayed_.assign(frame.begin(), frame.end());
+    displayed_id_ = id;
+  }
+
+  void complete_(Pending& pending, const FrameResult& result) {
+    publish_(pending.ticket, DisplayStage::DONE, result);
+    pending.done(result);
+  }
+
+  void publish_(uint64_t ticket, DisplayStage stage, const FrameResult& result = {}) {
+    events_.publish({
+        .ticket = ticket,
+        .stage = stage,
+        .time = std::chrono::system_clock::now(),
+        .result = result,
+    });
+  }
+
+  // Runs on the driver's worker as each phase of the frame in flight starts.
+  void observe_phase_(Epaper::Operation operation, Epaper::Phase phase) {
+    if (operation != Epaper::Operation::DISPLAY) {
+      return;
+    }
+    if (phase == Epaper::Phase::RAM_UPLOAD) {
+      publish_(in_flight_, DisplayStage::UPLOADING);
+    } else if (phase == Epaper::Phase::REFRESH) {
+      publish_(in_flight_, DisplayStage::REFRESHING);
+    }
+  }
+
+  // Hands `entry` to the driver. Its completion logs the outcome, has displayed frames persisted
+  // and starts the next queued frame; it runs on the driver's worker while the frame is still held.
+  void start_locked_(Queue::Entry entry) {
+    auto* epd = epd_.get();
+    const auto waited = Queue::Clock::now() - entry.submitted;
+    std::cout << "Frame priority " << entry.priority << " waited " << to_ms(waited) << " ms behind "
+              << entry.item.queue_depth << " queued" << std::endl;
+
+    const auto frame = entry.item.frame;
+    const auto owner = entry.item.owner;
+    auto producer = std::move(entry.item.producer);
+    const auto prepared = entry.item.prepared;
+    if (prepared.valid()) {
+      // Uploaded from memory once read in full; a late frame keeps the panel waiting for the rest,
+      // and a failed one fails on the panel like any other stream.
+      bool ready = prepared.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+      if (ready) {
+        try {
+          prepared.get();
+        } catch (...) {
+          ready = false;
+        }
+      }
+      producer = {};
+      if (!ready) {
+        producer = [prepared, frame](int row, std::span<uint8_t> packed_row) {
+          prepared.get();
+          std::ranges::copy_n(frame.begin() + static_cast<ptrdiff_t>(row * packed_row.size()),
+                              static_cast<ptrdiff_t>(packed_row.size()), packed_row.begin());
+          return true;
+        };
+      }
+    }
+    in_flight_ = entry.item.ticket;
+    auto on_complete = [this, epd, frame, waited, pending = std::move(entry.item)](
+                           const Epaper::DisplayResult& result) mutable {
+      FrameResult reply{.report = result.report,
+                        .waited = waited,
+                        .queue_depth = pending.queue_depth,
+                        .error = result.error};
+      switch (result.outcome) {
+        case Epaper::DisplayOutcome::SKIPPED:
+          std::cout << "Frame already displayed, refresh skipped" << std::endl;
+          reply.outcome = FrameOutcome::SKIPPED;
+          reply.frame_id = Epaper::frame_hash(frame);
+          persist_(frame, pending.owner, reply.frame_id, false);
+          break;
+        case Epaper::DisplayOutcome::DISPLAYED:
+          std::cout << "Displayed frame in " << to_ms(result.report.total) << " ms" << std::endl;
+          print_timings(result, epd->phase_stats());
+          if (pending.visible_at) {
+            print_target(result.report, *pending.visible_at);
+          }
+          reply.outcome = FrameOutcome::DISPLAYED;
+          reply.frame_id = Epaper::frame_hash(frame);
+          remember_displayed_(frame, reply.frame_id);
+          persist_(frame, pending.owner, reply.frame_id, true);
+          break;
+        default:
+          reply.outcome = FrameOutcome::FAILED;
+          if (!reply.error) {
+            reply.error = std::make_exception_ptr(std::runtime_error("Frame was cancelled"));
+          }
+          break;
+      }
+      complete_(pending, reply);
+
+      std::vector<Queue::Entry> expired;
+      {
+        std::lock_guard lock(mutex_);
+        busy_ = false;
+        if (result.outcome == Epaper::DisplayOutcome::DISPLAYED) {
+          display_phases_.clear();
+          for (const auto& phase : result.report.phases) {
+            display_phases_.push_back(phase.phase);
+          }
+        }
+        dispatch_locked_(expired);
+      }
+      drop_expired_(expired);
+    };
+    if (producer) {
+      epd->display_stream_async(std::move(producer), std::move(on_complete));
+    } else {
+      epd->display_async(frame, owner, std::move(on_complete));
+    }
+  }
+
+  const LastFrameStore last_frame_;
+  FrameCache& cache_;
+
+  std::mutex mutex_;
+  std::unique_ptr<Driver> epd_;
+  std::exception_ptr init_error_;
+  Queue queue_;
+  bool busy_ = false;  // a frame is with the driver
+  bool closed_ = false;
+  uint64_t next_ticket_ = 1;
+  std::atomic<uint64_t> in_flight_ = 0;  // ticket of the frame with the driver
+  // Copy of the frame on the glass, the base for delta frames.
+  std::vector<uint8_t> displayed_;
+  std::optional<uint64_t> displayed_id_;
+  // Phases of the last refresh, in order, for estimate_locked_().
+  std::vector<Epaper::Phase> display_phases_;
+  std::condition_variable_any timer_cv_;
+  bool timer_changed_ = false;  // a held frame was queued
+
+  EventHub<DisplayEvent> events_;
+
+  std::mutex prepare_mutex_;
+  std::condition_variable_any prepare_cv_;
+  std::deque<Preparation> preparations_;
+
+  std::thread init_;
+  std::jthread timer_;
+  std::array<std::jthread, PREPARERS> preparers_;
+
+  std::mutex persist_mutex_;
+  std::condition_variable_any persist_cv_;
+  std::deque<Persist> persists_;
+  std::jthread persister_;
+};
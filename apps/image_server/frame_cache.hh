@@ -0,0 +1,228 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "epd_frame_hash.hh"
+
+// A file mapped read-only, unmapped when the last reference goes.
+class MappedFrame {
+ public:
+  // Nothing if the file cannot be opened or mapped.
+  static auto open(const std::filesystem::path& path) -> std::shared_ptr<const MappedFrame> {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      return nullptr;
+    }
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(path, ec);
+    void* data = ec || size == 0 ? MAP_FAILED : mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping stays valid without the descriptor, and even after the file is removed.
+    ::close(fd);
+    if (data == MAP_FAILED) {
+      return nullptr;
+    }
+    return std::shared_ptr<const MappedFrame>(new MappedFrame(data, size));
+  }
+
+  ~MappedFrame() { munmap(data_, size_); }
+
+  MappedFrame(const MappedFrame&) = delete;
+  auto operator=(const MappedFrame&) -> MappedFrame& = delete;
+
+  [[nodiscard]] auto data() const -> std::span<const uint8_t> {
+    return {static_cast<const uint8_t*>(data_), size_};
+  }
+
+ private:
+  MappedFrame(void* data, size_t size) : data_(data), size_(size) {}
+
+  void* data_;
+  size_t size_;
+};
+
+// Packed frames on local flash, named by their frame_hash(), so a frame shown before can be shown
+// again by its ID alone. Once the files pass the budget, the least recently shown go first; the
+// order survives restarts through the files' modification times.
+class FrameCache {
+ public:
+  FrameCache(std::filesystem::path dir, uint64_t budget_bytes)
+      : dir_(std::move(dir)), budget_bytes_(budget_bytes) {
+    scan_();
+  }
+
+  // Directory from IMAGE_SERVER_FRAME_CACHE and budget from IMAGE_SERVER_FRAME_CACHE_MB, defaulting
+  // to frame_cache/ in the working directory and 128 MB (about 680 frames of the 7.3" panel).
+  static auto from_environment() -> FrameCache {
+    const char* dir = std::getenv("IMAGE_SERVER_FRAME_CACHE");
+    const char* budget = std::getenv("IMAGE_SERVER_FRAME_CACHE_MB");
+    return {dir != nullptr ? dir : "frame_cache",
+            (budget != nullptr ? std::strtoull(budget, nullptr, 10) : 128) * 1024 * 1024};
+  }
+
+  FrameCache(const FrameCache&) = delete;
+  auto operator=(const FrameCache&) -> FrameCache& = delete;
+
+  // Maps frame `id` for display and marks it as just used. Nothing if it is not cached, or the file
+  // no longer hashes to `id`, in which case it is dropped.
+  auto open(uint64_t id) -> std::shared_ptr<const MappedFrame> {
+    const auto path = path_of_(id);
+    {
+      std::lock_guard lock(mutex_);
+      if (!index_.contains(id)) {
+        return nullptr;
+      }
+    }
+    auto frame = MappedFrame::open(path);
+    if (!frame || Epaper::frame_hash(frame->data()) != id) {
+      std::cerr << "Dropping damaged cached frame " << path << std::endl;
+      std::lock_guard lock(mutex_);
+      remove_locked_(id);
+      return nullptr;
+    }
+    std::lock_guard lock(mutex_);
+    touch_locked_(id);
+    return frame;
+  }
+
+  // Marks frame `id` as just used. Returns false if it is not cached.
+  auto touch(uint64_t id) -> bool {
+    std::lock_guard lock(mutex_);
+    if (!index_.contains(id)) {
+      return false;
+    }
+    touch_locked_(id);
+    return true;
+  }
+
+  // Adds `frame` under `id` unless it is there already, then evicts down to the budget. Writes
+  // through a temporary file and rename() like LastFrameStore.
+  void store(std::span<const uint8_t> frame, uint64_t id) {
+    if (touch(id)) {
+      return;
+    }
+
+    const auto path = path_of_(id);
+    const auto tmp = std::filesystem::path(path).concat(".tmp");
+    {
+      std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+      file.write(reinterpret_cast<const char*>(frame.data()),
+                 static_cast<std::streamsize>(frame.size()));
+      if (!file.flush()) {
+        std::cerr << "Failed to write " << tmp << std::endl;
+        return;
+      }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+      std::cerr << "Failed to cache frame: " << ec.message() << std::endl;
+      return;
+    }
+
+    std::lock_guard lock(mutex_);
+    if (!index_.contains(id)) {
+      lru_.push_front({id, frame.size()});
+      index_.emplace(id, lru_.begin());
+      used_bytes_ += frame.size();
+    }
+    while (used_bytes_ > budget_bytes_ && lru_.size() > 1) {
+      remove_locked_(lru_.back().id);
+    }
+  }
+
+ private:
+  struct Entry {
+    uint64_t id;
+    uint64_t size;
+  };
+
+  static constexpr std::string_view SUFFIX = ".frame";
+
+  [[nodiscard]] auto path_of_(uint64_t id) const -> std::filesystem::path {
+    std::array<char, 16> hex{};
+    auto [end, ec] = std::to_chars(hex.begin(), hex.end(), id, 16);
+    return dir_ / (std::string(16 - (end - hex.begin()), '0') + std::string(hex.begin(), end) +
+                   std::string(SUFFIX));
+  }
+
+  // Indexes the frames already on disk, most recently used first, and clears out leftovers of
+  // interrupted writes.
+  void scan_() {
+    std::error_code ec;
+    std::filesystem::create_directories(dir_, ec);
+    std::vector<std::pair<std::filesystem::file_time_type, Entry>> found;
+    for (const auto& file : std::filesystem::directory_iterator(dir_, ec)) {
+      const auto name = file.path().filename().string();
+      uint64_t id = 0;
+      if (name.size() != 16 + SUFFIX.size() || !name.ends_with(SUFFIX) ||
+          std::from_chars(name.data(), name.data() + 16, id, 16).ptr != name.data() + 16) {
+        if (name.ends_with(".tmp")) {
+          std::filesystem::remove(file.path(), ec);
+        }
+        continue;
+      }
+      found.emplace_back(file.last_write_time(ec), Entry{id, file.file_size(ec)});
+    }
+    std::ranges::sort(found, std::greater{}, [](const auto& item) { return item.first; });
+    for (const auto& [time, entry] : found) {
+      lru_.push_back(entry);
+      index_.emplace(entry.id, std::prev(lru_.end()));
+      used_bytes_ += entry.size;
+    }
+    while (used_bytes_ > budget_bytes_ && !lru_.empty()) {
+      remove_locked_(lru_.back().id);
+    }
+    std::cout << "Frame cache holds " << lru_.size() << " frames in " << dir_ << std::endl;
+  }
+
+  void touch_locked_(uint64_t id) {
+    lru_.splice(lru_.begin(), lru_, index_.at(id));
+    std::error_code ec;
+    std::filesystem::last_write_time(path_of_(id), std::filesystem::file_time_type::clock::now(),
+                                     ec);
+  }
+
+  void remove_locked_(uint64_t id) {
+    const auto it = index_.find(id);
+    if (it == index_.end()) {
+      return;
+    }
+    used_bytes_ -= it->second->size;
+    lru_.erase(it->second);
+    index_.erase(it);
+    // Frames mapped for display keep their pages until they are unmapped.
+    std::error_code ec;
+    std::filesystem::remove(path_of_(id), ec);
+  }
+
+  const std::filesystem::path dir_;
+  const uint64_t budget_bytes_;
+
+  std::mutex mutex_;
+  std::list<Entry> lru_;  // most recently used first
+  std::unordered_map<uint64_t, std::list<Entry>::iterator> index_;
+  uint64_t used_bytes_ = 0;
+};
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+// Bounded queue of frames waiting for the panel, served highest priority first. A new frame
+// replaces the one already waiting at its own priority, so each producer class keeps only its
+// latest frame. When full, the lowest-priority frame is evicted unless the new one ranks lowest.
+// A frame with a start time is held until then, and keeps the panel free for itself: frames
+// below it only go if they are done before it is due. Timed and untimed frames have separate
+// slots, so an untimed frame never replaces a scheduled one of the same priority, nor the reverse.
+template <typename T>
+class FrameQueue {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Entry {
+    uint32_t priority = 0;
+    Clock::time_point submitted;
+    std::optional<Clock::time_point> expires;
+    std::optional<Clock::time_point> start;  // held until then
+    T item;
+  };
+
+  explicit FrameQueue(size_t capacity) : capacity_(std::max<size_t>(capacity, 1)) {}
+
+  [[nodiscard]] auto size() const -> size_t { return entries_.size(); }
+  [[nodiscard]] auto empty() const -> bool { return entries_.empty(); }
+
+  // Queues `entry`. Frames it replaces or evicts are appended to `displaced`; if the queue is full
+  // of frames that outrank it, `entry` itself is handed back instead.
+  auto push(Entry entry, std::vector<Entry>& displaced) -> std::optional<Entry> {
+    auto same = std::ranges::find_if(entries_, [&](const Entry& waiting) {
+      return waiting.priority == entry.priority &&
+             waiting.start.has_value() == entry.start.has_value();
+    });
+    if (same != entries_.end()) {
+      displaced.push_back(std::move(*same));
+      entries_.erase(same);
+    } else if (entries_.size() >= capacity_) {
+      if (entries_.back().priority >= entry.priority) {
+        return entry;
+      }
+      displaced.push_back(std::move(entries_.back()));
+      entries_.pop_back();
+    }
+
+    auto position = std::ranges::upper_bound(entries_, entry.priority, std::ranges::greater{},
+                                             &Entry::priority);
+    entries_.insert(position, std::move(entry));
+    return std::nullopt;
+  }
+
+  // Removes and returns the frames whose TTL has run out.
+  auto take_expired(Clock::time_point now) -> std::vector<Entry> {
+    std::vector<Entry> expired;
+    std::erase_if(entries_, [&](Entry& entry) {
+      if (!entry.expires || *entry.expires > now) {
+        return false;
+      }
+      expired.push_back(std::move(entry));
+      return true;
+    });
+    return expired;
+  }
+
+  // The most urgent frame that can go to the panel at `now`, when a frame keeps it for `runtime`.
+  auto pop(Clock::time_point now, Clock::duration runtime) -> std::optional<Entry> {
+    std::optional<Clock::time_point> reserved;  // earliest start among the frames ranked higher
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+      if (it->start && *it->start > now) {
+        reserved = std::min(reserved.value_or(*it->start), *it->start);
+        continue;
+      }
+      if (reserved && now + runtime > *reserved) {
+        continue;
+      }
+      auto entry = std::move(*it);
+      entries_.erase(it);
+      return entry;
+    }
+    return std::nullopt;
+  }
+
+  // When the next held frame is due, if any is still held at `now`.
+  [[nodiscard]] auto next_start(Clock::time_point now) const -> std::optional<Clock::time_point> {
+    std::optional<Clock::time_point> next;
+    for (const auto& entry : entries_) {
+      if (entry.start && *entry.start > now) {
+        next = std::min(next.value_or(*entry.start), *entry.start);
+      }
+    }
+    return next;
+  }
+
+  // Empties the queue, e.g. on shutdown.
+  auto take_all() -> std::vector<Entry> { return std::exchange(entries_, {}); }
+
+ private:
+  const size_t capacity_;
+  // Sorted by descending priority; at most one timed and one untimed entry per priority.
+  std::vector<Entry> entries_;
+};
@@ -24,19 +24,47 @@ _sym_db = _symbol_database.Default()
 
 
 
-DESCRIPTOR = _descriptor_pool.Default().AddSerializedFile(b'\n\x12image_server.proto\x12\x0cimage_server\"\x1e\n\x0b\x44\x61taRequest\x12\x0f\n\x07payload\x18\x01 \x01(\x0c\"4\n\x0c\x44\x61taResponse\x12$\n\x06status\x18\x01 \x01(\x0e\x32\x14.image_server.Status*4\n\x06Status\x12\x06\n\x02OK\x10\x00\x12\x17\n\x13IMAGE_SIZE_MISMATCH\x10\x01\x12\t\n\x05\x45RROR\x10\x02\x32P\n\x0b\x44\x61taService\x12\x41\n\x08SendData\x12\x19.image_server.DataRequest\x1a\x1a.image_server.DataResponseb\x06proto3')
+DESCRIPTOR = _descriptor_pool.Default().AddSerializedFile(b'\n\x12image_server.proto\x12\x0cimage_server\"\xb5\x02\n\x0eProcessingSpec\x12-\n\x03\x66it\x18\x01 \x01(\x0e\x32 .image_server.ProcessingSpec.Fit\x12\x33\n\x06\x64ither\x18\x02 \x01(\x0e\x32#.image_server.ProcessingSpec.Dither\x12\x10\n\x08\x65xposure\x18\x03 \x01(\x02\x12\x15\n\x08\x63ontrast\x18\x04 \x01(\x02H\x00\x88\x01\x01\x12\x17\n\nsaturation\x18\x05 \x01(\x02H\x01\x88\x01\x01\"*\n\x03\x46it\x12\t\n\x05\x43OVER\x10\x00\x12\x0b\n\x07\x43ONTAIN\x10\x01\x12\x0b\n\x07STRETCH\x10\x02\"5\n\x06\x44ither\x12\x13\n\x0f\x46LOYD_STEINBERG\x10\x00\x12\x0c\n\x08\x41TKINSON\x10\x01\x12\x08\n\x04NONE\x10\x02\x42\x0b\n\t_contrastB\r\n\x0b_saturation\"*\n\nDeltaRange\x12\x0e\n\x06offset\x18\x01 \x01(\r\x12\x0c\n\x04\x62its\x18\x02 \x01(\x0c\"\x92\x02\n\x0b\x44\x61taRequest\x12\x0f\n\x07payload\x18\x01 \x01(\x0c\x12\x10\n\x08priority\x18\x02 \x01(\r\x12\x0e\n\x06ttl_ms\x18\x03 \x01(\r\x12(\n\x08\x65ncoding\x18\x04 \x01(\x0e\x32\x16.image_server.Encoding\x12\x15\n\rbase_frame_id\x18\x05 \x01(\x04\x12\'\n\x05\x64\x65lta\x18\x06 \x03(\x0b\x32\x18.image_server.DeltaRange\x12\r\n\x05width\x18\x07 \x01(\r\x12\x0e\n\x06height\x18\x08 \x01(\r\x12\x30\n\nprocessing\x18\t \x01(\x0b\x32\x1c.image_server.ProcessingSpec\x12\x15\n\rvisible_at_us\x18\n \x01(\x03\"l\n\x0c\x44\x61taResponse\x12$\n\x06status\x18\x01 \x01(\x0e\x32\x14.image_server.Status\x12\x13\n\x0bqueue_depth\x18\x02 \x01(\r\x12\x0f\n\x07wait_ms\x18\x03 \x01(\r\x12\x10\n\x08\x66rame_id\x18\x04 \x01(\x04\"Z\n\rCachedRequest\x12\x10\n\x08\x66rame_id\x18\x01 \x01(\x04\x12\x10\n\x08priority\x18\x02 \x01(\r\x12\x0e\n\x06ttl_ms\x18\x03 \x01(\r\x12\x15\n\rvisible_at_us\x18\x04 \x01(\x03\"]\n\rPlaylistEntry\x12(\n\x05image\x18\x01 \x01(\x0b\x32\x19.image_server.DataRequest\x12\x12\n\nduration_s\x18\x02 \x01(\r\x12\x0e\n\x06window\x18\x03 \x01(\t\"[\n\x08Playlist\x12,\n\x07\x65ntries\x18\x01 \x03(\x0b\x32\x1b.image_server.PlaylistEntry\x12\x0f\n\x07shuffle\x18\x02 \x01(\x08\x12\x10\n\x08priority\x18\x03 \x01(\r\"G\n\x10PlaylistResponse\x12$\n\x06status\x18\x01 \x01(\x0e\x32\x14.image_server.Status\x12\r\n\x05\x65ntry\x18\x02 \x01(\r\"O\n\nFrameChunk\x12\x11\n\tfirst_row\x18\x01 \x01(\r\x12\x0c\n\x04rows\x18\x02 \x01(\x0c\x12\x10\n\x08priority\x18\x03 \x01(\r\x12\x0e\n\x06ttl_ms\x18\x04 \x01(\r\"F\n\x0eSubmitResponse\x12$\n\x06status\x18\x01 \x01(\x0e\x32\x14.image_server.Status\x12\x0e\n\x06ticket\x18\x02 \x01(\x04\"\x1e\n\x0cWatchRequest\x12\x0e\n\x06ticket\x18\x01 \x01(\x04\"\xa8\x01\n\x0c\x44isplayEvent\x12\x0e\n\x06ticket\x18\x01 \x01(\x04\x12)\n\x05stage\x18\x02 \x01(\x0e\x32\x1a.image_server.DisplayStage\x12\x14\n\x0ctimestamp_us\x18\x03 \x01(\x03\x12$\n\x06status\x18\x04 \x01(\x0e\x32\x14.image_server.Status\x12\x0f\n\x07wait_ms\x18\x05 \x01(\r\x12\x10\n\x08\x66rame_id\x18\x06 \x01(\x04*\xad\x01\n\x06Status\x12\x06\n\x02OK\x10\x00\x12\x17\n\x13IMAGE_SIZE_MISMATCH\x10\x01\x12\t\n\x05\x45RROR\x10\x02\x12\x0e\n\nSUPERSEDED\x10\x03\x12\x0b\n\x07\x45XPIRED\x10\x04\x12\x0e\n\nQUEUE_FULL\x10\x05\x12\x11\n\rBASE_MISMATCH\x10\x06\x12\x11\n\rINVALID_IMAGE\x10\x07\x12\x0e\n\nNOT_CACHED\x10\x08\x12\x14\n\x10INVALID_PLAYLIST\x10\t*8\n\x08\x45ncoding\x12\x07\n\x03RAW\x10\x00\x12\r\n\tBASE6_RLE\x10\x01\x12\t\n\x05IMAGE\x10\x02\x12\t\n\x05RGB24\x10\x03*C\n\x0c\x44isplayStage\x12\n\n\x06QUEUED\x10\x00\x12\r\n\tUPLOADING\x10\x01\x12\x0e\n\nREFRESHING\x10\x02\x12\x08\n\x04\x44ONE\x10\x03\x32\xb9\x03\n\x0b\x44\x61taService\x12\x41\n\x08SendData\x12\x19.image_server.DataRequest\x1a\x1a.image_server.DataResponse\x12\x45\n\nSubmitData\x12\x19.image_server.DataRequest\x1a\x1c.image_server.SubmitResponse\x12H\n\x0cWatchDisplay\x12\x1a.image_server.WatchRequest\x1a\x1a.image_server.DisplayEvent0\x01\x12\x45\n\x0bUploadFrame\x12\x18.image_server.FrameChunk\x1a\x1a.image_server.DataResponse(\x01\x12H\n\rDisplayCached\x12\x1b.image_server.CachedRequest\x1a\x1a.image_server.DataResponse\x12\x45\n\x0bSetPlaylist\x12\x16.image_server.Playlist\x1a\x1e.image_server.PlaylistResponseb\x06proto3')
 
 _globals = globals()
 _builder.BuildMessageAndEnumDescriptors(DESCRIPTOR, _globals)
 _builder.BuildTopDescriptorsAndMessages(DESCRIPTOR, 'image_server_pb2', _globals)
 if not _descriptor._USE_C_DESCRIPTORS:
   DESCRIPTOR._loaded_options = None
-  _globals['_STATUS']._serialized_start=122
-  _globals['_STATUS']._serialized_end=174
-  _globals['_DATAREQUEST']._serialized_start=36
-  _globals['_DATAREQUEST']._serialized_end=66
-  _globals['_DATARESPONSE']._serialized_start=68
-  _globals['_DATARESPONSE']._serialized_end=120
-  _globals['_DATASERVICE']._serialized_start=176
-  _globals['_DATASERVICE']._serialized_end=256
+  _globals['_STATUS']._serialized_start=1489
+  _globals['_STATUS']._serialized_end=1662
+  _globals['_ENCODING']._serialized_start=1664
+  _globals['_ENCODING']._serialized_end=1720
+  _globals['_DISPLAYSTAGE']._serialized_start=1722
+  _globals['_DISPLAYSTAGE']._serialized_end=1789
+  _globals['_PROCESSINGSPEC']._serialized_start=37
+  _globals['_PROCESSINGSPEC']._serialized_end=346
+  _globals['_PROCESSINGSPEC_FIT']._serialized_start=221
+  _globals['_PROCESSINGSPEC_FIT']._serialized_end=263
+  _globals['_PROCESSINGSPEC_DITHER']._serialized_start=265
+  _globals['_PROCESSINGSPEC_DITHER']._serialized_end=318
+  _globals['_DELTARANGE']._serialized_start=348
+  _globals['_DELTARANGE']._serialized_end=390
+  _globals['_DATAREQUEST']._serialized_start=393
+  _globals['_DATAREQUEST']._serialized_end=667
+  _globals['_DATARESPONSE']._serialized_start=669
+  _globals['_DATARESPONSE']._serialized_end=777
+  _globals['_CACHEDREQUEST']._serialized_start=779
+  _globals['_CACHEDREQUEST']._serialized_end=869
+  _globals['_PLAYLISTENTRY']._serialized_start=871
+  _globals['_PLAYLISTENTRY']._serialized_end=964
+  _globals['_PLAYLIST']._serialized_start=966
+  _globals['_PLAYLIST']._serialized_end=1057
+  _globals['_PLAYLISTRESPONSE']._serialized_start=1059
+  _globals['_PLAYLISTRESPONSE']._serialized_end=1130
+  _globals['_FRAMECHUNK']._serialized_start=1132
+  _globals['_FRAMECHUNK']._serialized_end=1211
+  _globals['_SUBMITRESPONSE']._serialized_start=1213
+  _globals['_SUBMITRESPONSE']._serialized_end=1283
+  _globals['_WATCHREQUEST']._serialized_start=1285
+  _globals['_WATCHREQUEST']._serialized_end=1315
+  _globals['_DISPLAYEVENT']._serialized_start=1318
+  _globals['_DISPLAYEVENT']._serialized_end=1486
+  _globals['_DATASERVICE']._serialized_start=1792
+  _globals['_DATASERVICE']._serialized_end=2233
 # @@protoc_insertion_point(module_scope)
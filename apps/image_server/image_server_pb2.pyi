@@ -4,7 +4,9 @@ isort:skip_file
 """
 
 import builtins
+import collections.abc
 import google.protobuf.descriptor
+import google.protobuf.internal.containers
 import google.protobuf.internal.enum_type_wrapper
 import google.protobuf.message
 import sys
@@ -26,6 +28,20 @@ class _StatusEnumTypeWrapper(google.protobuf.internal.enum_type_wrapper._EnumTyp
     OK: _Status.ValueType  # 0
     IMAGE_SIZE_MISMATCH: _Status.ValueType  # 1
     ERROR: _Status.ValueType  # 2
+    SUPERSEDED: _Status.ValueType  # 3
+    """表示前に新しいフレームで置き換えられた"""
+    EXPIRED: _Status.ValueType  # 4
+    """ttl_ms 以内に表示できなかった"""
+    QUEUE_FULL: _Status.ValueType  # 5
+    """キューが優先度の高いフレームで埋まっている"""
+    BASE_MISMATCH: _Status.ValueType  # 6
+    """base_frame_id が表示中のフレームではない。フレーム全体を送り直す"""
+    INVALID_IMAGE: _Status.ValueType  # 7
+    """IMAGE を読めない、RGB24 の大きさが合わない、または画像が大きすぎる"""
+    NOT_CACHED: _Status.ValueType  # 8
+    """frame_id のフレームがサーバーのキャッシュにない。フレーム全体を送り直す"""
+    INVALID_PLAYLIST: _Status.ValueType  # 9
+    """duration_s が 0、window の書式が正しくない、または image が差分フレーム"""
 
 class Status(_Status, metaclass=_StatusEnumTypeWrapper):
     """enum 定義"""
@@ -33,8 +49,173 @@ class Status(_Status, metaclass=_StatusEnumTypeWrapper):
 OK: Status.ValueType  # 0
 IMAGE_SIZE_MISMATCH: Status.ValueType  # 1
 ERROR: Status.ValueType  # 2
+SUPERSEDED: Status.ValueType  # 3
+"""表示前に新しいフレームで置き換えられた"""
+EXPIRED: Status.ValueType  # 4
+"""ttl_ms 以内に表示できなかった"""
+QUEUE_FULL: Status.ValueType  # 5
+"""キューが優先度の高いフレームで埋まっている"""
+BASE_MISMATCH: Status.ValueType  # 6
+"""base_frame_id が表示中のフレームではない。フレーム全体を送り直す"""
+INVALID_IMAGE: Status.ValueType  # 7
+"""IMAGE を読めない、RGB24 の大きさが合わない、または画像が大きすぎる"""
+NOT_CACHED: Status.ValueType  # 8
+"""frame_id のフレームがサーバーのキャッシュにない。フレーム全体を送り直す"""
+INVALID_PLAYLIST: Status.ValueType  # 9
+"""duration_s が 0、window の書式が正しくない、または image が差分フレーム"""
 global___Status = Status
 
+class _DisplayStage:
+    ValueType = typing.NewType("ValueType", builtins.int)
+    V: typing_extensions.TypeAlias = ValueType
+
+class _DisplayStageEnumTypeWrapper(google.protobuf.internal.enum_type_wrapper._EnumTypeWrapper[_DisplayStage.ValueType], builtins.type):
+    DESCRIPTOR: google.protobuf.descriptor.EnumDescriptor
+    QUEUED: _DisplayStage.ValueType  # 0
+    """キューで待機中"""
+    UPLOADING: _DisplayStage.ValueType  # 1
+    """パネルの RAM へ転送中"""
+    REFRESHING: _DisplayStage.ValueType  # 2
+    """パネルを書き換え中"""
+    DONE: _DisplayStage.ValueType  # 3
+    """完了 (結果は status)"""
+
+class DisplayStage(_DisplayStage, metaclass=_DisplayStageEnumTypeWrapper):
+    """表示処理の段階"""
+
+QUEUED: DisplayStage.ValueType  # 0
+"""キューで待機中"""
+UPLOADING: DisplayStage.ValueType  # 1
+"""パネルの RAM へ転送中"""
+REFRESHING: DisplayStage.ValueType  # 2
+"""パネルを書き換え中"""
+DONE: DisplayStage.ValueType  # 3
+"""完了 (結果は status)"""
+global___DisplayStage = DisplayStage
+
+class _Encoding:
+    ValueType = typing.NewType("ValueType", builtins.int)
+    V: typing_extensions.TypeAlias = ValueType
+
+class _EncodingEnumTypeWrapper(google.protobuf.internal.enum_type_wrapper._EnumTypeWrapper[_Encoding.ValueType], builtins.type):
+    DESCRIPTOR: google.protobuf.descriptor.EnumDescriptor
+    RAW: _Encoding.ValueType  # 0
+    """4bpp のまま (1 バイトに 2 画素)"""
+    BASE6_RLE: _Encoding.ValueType  # 1
+    """6 色を 3 画素 1 バイトに詰め、同色の連続は長さで表す (apps/common/frame_codec.hh)"""
+    IMAGE: _Encoding.ValueType  # 2
+    """JPEG/PNG/BMP などの画像ファイル。サーバーが processing に従って変換する"""
+    RGB24: _Encoding.ValueType  # 3
+    """1 画素 3 バイトの RGB (width x height)。サーバーが processing に従って変換する"""
+
+class Encoding(_Encoding, metaclass=_EncodingEnumTypeWrapper):
+    """payload の符号化方式"""
+
+RAW: Encoding.ValueType  # 0
+"""4bpp のまま (1 バイトに 2 画素)"""
+BASE6_RLE: Encoding.ValueType  # 1
+"""6 色を 3 画素 1 バイトに詰め、同色の連続は長さで表す (apps/common/frame_codec.hh)"""
+IMAGE: Encoding.ValueType  # 2
+"""JPEG/PNG/BMP などの画像ファイル。サーバーが processing に従って変換する"""
+RGB24: Encoding.ValueType  # 3
+"""1 画素 3 バイトの RGB (width x height)。サーバーが processing に従って変換する"""
+global___Encoding = Encoding
+
+@typing.final
+class ProcessingSpec(google.protobuf.message.Message):
+    """IMAGE / RGB24 をパネルの画像にする方法"""
+
+    DESCRIPTOR: google.protobuf.descriptor.Descriptor
+
+    class _Fit:
+        ValueType = typing.NewType("ValueType", builtins.int)
+        V: typing_extensions.TypeAlias = ValueType
+
+    class _FitEnumTypeWrapper(google.protobuf.internal.enum_type_wrapper._EnumTypeWrapper[ProcessingSpec._Fit.ValueType], builtins.type):
+        DESCRIPTOR: google.protobuf.descriptor.EnumDescriptor
+        COVER: ProcessingSpec._Fit.ValueType  # 0
+        """縦横比を保って画面を覆い、はみ出た部分を切り取る"""
+        CONTAIN: ProcessingSpec._Fit.ValueType  # 1
+        """縦横比を保って画面に収め、余白は白"""
+        STRETCH: ProcessingSpec._Fit.ValueType  # 2
+        """縦横比を無視して画面に合わせる"""
+
+    class Fit(_Fit, metaclass=_FitEnumTypeWrapper): ...
+    COVER: ProcessingSpec.Fit.ValueType  # 0
+    """縦横比を保って画面を覆い、はみ出た部分を切り取る"""
+    CONTAIN: ProcessingSpec.Fit.ValueType  # 1
+    """縦横比を保って画面に収め、余白は白"""
+    STRETCH: ProcessingSpec.Fit.ValueType  # 2
+    """縦横比を無視して画面に合わせる"""
+
+    class _Dither:
+        ValueType = typing.NewType("ValueType", builtins.int)
+        V: typing_extensions.TypeAlias = ValueType
+
+    class _DitherEnumTypeWrapper(google.protobuf.internal.enum_type_wrapper._EnumTypeWrapper[ProcessingSpec._Dither.ValueType], builtins.type):
+        DESCRIPTOR: google.protobuf.descriptor.EnumDescriptor
+        FLOYD_STEINBERG: ProcessingSpec._Dither.ValueType  # 0
+        ATKINSON: ProcessingSpec._Dither.ValueType  # 1
+        NONE: ProcessingSpec._Dither.ValueType  # 2
+        """最も近い色に置き換えるだけ"""
+
+    class Dither(_Dither, metaclass=_DitherEnumTypeWrapper): ...
+    FLOYD_STEINBERG: ProcessingSpec.Dither.ValueType  # 0
+    ATKINSON: ProcessingSpec.Dither.ValueType  # 1
+    NONE: ProcessingSpec.Dither.ValueType  # 2
+    """最も近い色に置き換えるだけ"""
+
+    FIT_FIELD_NUMBER: builtins.int
+    DITHER_FIELD_NUMBER: builtins.int
+    EXPOSURE_FIELD_NUMBER: builtins.int
+    CONTRAST_FIELD_NUMBER: builtins.int
+    SATURATION_FIELD_NUMBER: builtins.int
+    fit: global___ProcessingSpec.Fit.ValueType
+    dither: global___ProcessingSpec.Dither.ValueType
+    exposure: builtins.float
+    """露出補正 (EV)。0 で無変更"""
+    contrast: builtins.float
+    """中間の灰色を中心にした倍率。省略時は 1 (無変更)"""
+    saturation: builtins.float
+    """彩度の倍率。省略時は 1 (無変更)"""
+    def __init__(
+        self,
+        *,
+        fit: global___ProcessingSpec.Fit.ValueType = ...,
+        dither: global___ProcessingSpec.Dither.ValueType = ...,
+        exposure: builtins.float = ...,
+        contrast: builtins.float | None = ...,
+        saturation: builtins.float | None = ...,
+    ) -> None: ...
+    def HasField(self, field_name: typing.Literal["_contrast", b"_contrast", "_saturation", b"_saturation", "contrast", b"contrast", "saturation", b"saturation"]) -> builtins.bool: ...
+    def ClearField(self, field_name: typing.Literal["_contrast", b"_contrast", "_saturation", b"_saturation", "contrast", b"contrast", "dither", b"dither", "exposure", b"exposure", "fit", b"fit", "saturation", b"saturation"]) -> None: ...
+    @typing.overload
+    def WhichOneof(self, oneof_group: typing.Literal["_contrast", b"_contrast"]) -> typing.Literal["contrast"] | None: ...
+    @typing.overload
+    def WhichOneof(self, oneof_group: typing.Literal["_saturation", b"_saturation"]) -> typing.Literal["saturation"] | None: ...
+
+global___ProcessingSpec = ProcessingSpec
+
+@typing.final
+class DeltaRange(google.protobuf.message.Message):
+    """差分フレームの 1 区間: offset バイト目から bits を基準フレームに XOR する"""
+
+    DESCRIPTOR: google.protobuf.descriptor.Descriptor
+
+    OFFSET_FIELD_NUMBER: builtins.int
+    BITS_FIELD_NUMBER: builtins.int
+    offset: builtins.int
+    bits: builtins.bytes
+    def __init__(
+        self,
+        *,
+        offset: builtins.int = ...,
+        bits: builtins.bytes = ...,
+    ) -> None: ...
+    def ClearField(self, field_name: typing.Literal["bits", b"bits", "offset", b"offset"]) -> None: ...
+
+global___DeltaRange = DeltaRange
+
 @typing.final
 class DataRequest(google.protobuf.message.Message):
     """リクエスト: 可変長の byte 列"""
@@ -42,13 +223,53 @@ class DataRequest(google.protobuf.message.Message):
     DESCRIPTOR: google.protobuf.descriptor.Descriptor
 
     PAYLOAD_FIELD_NUMBER: builtins.int
+    PRIORITY_FIELD_NUMBER: builtins.int
+    TTL_MS_FIELD_NUMBER: builtins.int
+    ENCODING_FIELD_NUMBER: builtins.int
+    BASE_FRAME_ID_FIELD_NUMBER: builtins.int
+    DELTA_FIELD_NUMBER: builtins.int
+    WIDTH_FIELD_NUMBER: builtins.int
+    HEIGHT_FIELD_NUMBER: builtins.int
+    PROCESSING_FIELD_NUMBER: builtins.int
+    VISIBLE_AT_US_FIELD_NUMBER: builtins.int
     payload: builtins.bytes
+    priority: builtins.int
+    """大きいほど先に表示される。同じ優先度では新しいフレームが待機中のものを置き換える (visible_at_us の有無が同じもの同士)"""
+    ttl_ms: builtins.int
+    """この時間内に表示が始まらなければ破棄する。0 は無期限"""
+    encoding: global___Encoding.ValueType
+    base_frame_id: builtins.int
+    """0 以外なら payload の代わりに delta をこの ID のフレームに適用する"""
+    width: builtins.int
+    """RGB24 のみ"""
+    height: builtins.int
+    """RGB24 のみ"""
+    visible_at_us: builtins.int
+    """0 以外なら、この UNIX 時刻 (マイクロ秒) に書き換えが終わるように表示を始める。時刻指定のフレームは同じ優先度の時刻指定なしのフレームを置き換えず、置き換えられもしない"""
+    @property
+    def delta(self) -> google.protobuf.internal.containers.RepeatedCompositeFieldContainer[global___DeltaRange]:
+        """変化したバイト区間 (base_frame_id を指定したときのみ)"""
+
+    @property
+    def processing(self) -> global___ProcessingSpec:
+        """IMAGE / RGB24 のみ"""
+
     def __init__(
         self,
         *,
         payload: builtins.bytes = ...,
+        priority: builtins.int = ...,
+        ttl_ms: builtins.int = ...,
+        encoding: global___Encoding.ValueType = ...,
+        base_frame_id: builtins.int = ...,
+        delta: collections.abc.Iterable[global___DeltaRange] | None = ...,
+        width: builtins.int = ...,
+        height: builtins.int = ...,
+        processing: global___ProcessingSpec | None = ...,
+        visible_at_us: builtins.int = ...,
     ) -> None: ...
-    def ClearField(self, field_name: typing.Literal["payload", b"payload"]) -> None: ...
+    def HasField(self, field_name: typing.Literal["processing", b"processing"]) -> builtins.bool: ...
+    def ClearField(self, field_name: typing.Literal["base_frame_id", b"base_frame_id", "delta", b"delta", "encoding", b"encoding", "height", b"height", "payload", b"payload", "priority", b"priority", "processing", b"processing", "ttl_ms", b"ttl_ms", "visible_at_us", b"visible_at_us", "width", b"width"]) -> None: ...
 
 global___DataRequest = DataRequest
 
@@ -59,12 +280,233 @@ class DataResponse(google.protobuf.message.Message):
     DESCRIPTOR: google.protobuf.descriptor.Descriptor
 
     STATUS_FIELD_NUMBER: builtins.int
+    QUEUE_DEPTH_FIELD_NUMBER: builtins.int
+    WAIT_MS_FIELD_NUMBER: builtins.int
+    FRAME_ID_FIELD_NUMBER: builtins.int
     status: global___Status.ValueType
+    queue_depth: builtins.int
+    """受信時に待機していたフレーム数"""
+    wait_ms: builtins.int
+    """受信から表示開始 (または破棄) までの待ち時間"""
+    frame_id: builtins.int
+    """表示中のフレームの ID。次の差分フレームの base_frame_id に使う"""
     def __init__(
         self,
         *,
         status: global___Status.ValueType = ...,
+        queue_depth: builtins.int = ...,
+        wait_ms: builtins.int = ...,
+        frame_id: builtins.int = ...,
     ) -> None: ...
-    def ClearField(self, field_name: typing.Literal["status", b"status"]) -> None: ...
+    def ClearField(self, field_name: typing.Literal["frame_id", b"frame_id", "queue_depth", b"queue_depth", "status", b"status", "wait_ms", b"wait_ms"]) -> None: ...
 
 global___DataResponse = DataResponse
+
+@typing.final
+class CachedRequest(google.protobuf.message.Message):
+    """DisplayCached のリクエスト"""
+
+    DESCRIPTOR: google.protobuf.descriptor.Descriptor
+
+    FRAME_ID_FIELD_NUMBER: builtins.int
+    PRIORITY_FIELD_NUMBER: builtins.int
+    TTL_MS_FIELD_NUMBER: builtins.int
+    VISIBLE_AT_US_FIELD_NUMBER: builtins.int
+    frame_id: builtins.int
+    """以前に表示したフレームの ID (DataResponse の frame_id)"""
+    priority: builtins.int
+    """DataRequest と同じ"""
+    ttl_ms: builtins.int
+    """DataRequest と同じ"""
+    visible_at_us: builtins.int
+    """DataRequest と同じ"""
+    def __init__(
+        self,
+        *,
+        frame_id: builtins.int = ...,
+        priority: builtins.int = ...,
+        ttl_ms: builtins.int = ...,
+        visible_at_us: builtins.int = ...,
+    ) -> None: ...
+    def ClearField(self, field_name: typing.Literal["frame_id", b"frame_id", "priority", b"priority", "ttl_ms", b"ttl_ms", "visible_at_us", b"visible_at_us"]) -> None: ...
+
+global___CachedRequest = CachedRequest
+
+@typing.final
+class PlaylistEntry(google.protobuf.message.Message):
+    """スライドショーの 1 枚"""
+
+    DESCRIPTOR: google.protobuf.descriptor.Descriptor
+
+    IMAGE_FIELD_NUMBER: builtins.int
+    DURATION_S_FIELD_NUMBER: builtins.int
+    WINDOW_FIELD_NUMBER: builtins.int
+    duration_s: builtins.int
+    """次の画像に切り替えるまでの秒数"""
+    window: builtins.str
+    """crontab と同じ "分 時 日 月 曜日" の書式で、表示してよい時刻。空ならいつでも"""
+    @property
+    def image(self) -> global___DataRequest:
+        """表示する画像。priority, ttl_ms, visible_at_us と差分は使わない"""
+
+    def __init__(
+        self,
+        *,
+        image: global___DataRequest | None = ...,
+        duration_s: builtins.int = ...,
+        window: builtins.str = ...,
+    ) -> None: ...
+    def HasField(self, field_name: typing.Literal["image", b"image"]) -> builtins.bool: ...
+    def ClearField(self, field_name: typing.Literal["duration_s", b"duration_s", "image", b"image", "window", b"window"]) -> None: ...
+
+global___PlaylistEntry = PlaylistEntry
+
+@typing.final
+class Playlist(google.protobuf.message.Message):
+    """サーバーが順に表示するスライドショー。サーバーのディスクに保存され、再起動後も続く"""
+
+    DESCRIPTOR: google.protobuf.descriptor.Descriptor
+
+    ENTRIES_FIELD_NUMBER: builtins.int
+    SHUFFLE_FIELD_NUMBER: builtins.int
+    PRIORITY_FIELD_NUMBER: builtins.int
+    shuffle: builtins.bool
+    """一巡ごとに順番を入れ替える"""
+    priority: builtins.int
+    """DataRequest と同じ"""
+    @property
+    def entries(self) -> google.protobuf.internal.containers.RepeatedCompositeFieldContainer[global___PlaylistEntry]:
+        """空ならスライドショーを止める"""
+
+    def __init__(
+        self,
+        *,
+        entries: collections.abc.Iterable[global___PlaylistEntry] | None = ...,
+        shuffle: builtins.bool = ...,
+        priority: builtins.int = ...,
+    ) -> None: ...
+    def ClearField(self, field_name: typing.Literal["entries", b"entries", "priority", b"priority", "shuffle", b"shuffle"]) -> None: ...
+
+global___Playlist = Playlist
+
+@typing.final
+class PlaylistResponse(google.protobuf.message.Message):
+    """SetPlaylist のレスポンス"""
+
+    DESCRIPTOR: google.protobuf.descriptor.Descriptor
+
+    STATUS_FIELD_NUMBER: builtins.int
+    ENTRY_FIELD_NUMBER: builtins.int
+    status: global___Status.ValueType
+    entry: builtins.int
+    """status が OK でないとき、問題のあるエントリの番号"""
+    def __init__(
+        self,
+        *,
+        status: global___Status.ValueType = ...,
+        entry: builtins.int = ...,
+    ) -> None: ...
+    def ClearField(self, field_name: typing.Literal["entry", b"entry", "status", b"status"]) -> None: ...
+
+global___PlaylistResponse = PlaylistResponse
+
+@typing.final
+class FrameChunk(google.protobuf.message.Message):
+    """UploadFrame で送るフレームの断片。行の途中では分割せず、先頭の行から順に送る"""
+
+    DESCRIPTOR: google.protobuf.descriptor.Descriptor
+
+    FIRST_ROW_FIELD_NUMBER: builtins.int
+    ROWS_FIELD_NUMBER: builtins.int
+    PRIORITY_FIELD_NUMBER: builtins.int
+    TTL_MS_FIELD_NUMBER: builtins.int
+    first_row: builtins.int
+    """この断片の最初の行"""
+    rows: builtins.bytes
+    """1 行以上の行データ"""
+    priority: builtins.int
+    """最初の断片のみ。DataRequest と同じ"""
+    ttl_ms: builtins.int
+    """最初の断片のみ。DataRequest と同じ"""
+    def __init__(
+        self,
+        *,
+        first_row: builtins.int = ...,
+        rows: builtins.bytes = ...,
+        priority: builtins.int = ...,
+        ttl_ms: builtins.int = ...,
+    ) -> None: ...
+    def ClearField(self, field_name: typing.Literal["first_row", b"first_row", "priority", b"priority", "rows", b"rows", "ttl_ms", b"ttl_ms"]) -> None: ...
+
+global___FrameChunk = FrameChunk
+
+@typing.final
+class SubmitResponse(google.protobuf.message.Message):
+    """SubmitData のレスポンス: 受付結果とチケット番号"""
+
+    DESCRIPTOR: google.protobuf.descriptor.Descriptor
+
+    STATUS_FIELD_NUMBER: builtins.int
+    TICKET_FIELD_NUMBER: builtins.int
+    status: global___Status.ValueType
+    ticket: builtins.int
+    """WatchDisplay で進捗を追うための番号"""
+    def __init__(
+        self,
+        *,
+        status: global___Status.ValueType = ...,
+        ticket: builtins.int = ...,
+    ) -> None: ...
+    def ClearField(self, field_name: typing.Literal["status", b"status", "ticket", b"ticket"]) -> None: ...
+
+global___SubmitResponse = SubmitResponse
+
+@typing.final
+class WatchRequest(google.protobuf.message.Message):
+    DESCRIPTOR: google.protobuf.descriptor.Descriptor
+
+    TICKET_FIELD_NUMBER: builtins.int
+    ticket: builtins.int
+    """0 なら全フレームのイベントを受け取る"""
+    def __init__(
+        self,
+        *,
+        ticket: builtins.int = ...,
+    ) -> None: ...
+    def ClearField(self, field_name: typing.Literal["ticket", b"ticket"]) -> None: ...
+
+global___WatchRequest = WatchRequest
+
+@typing.final
+class DisplayEvent(google.protobuf.message.Message):
+    DESCRIPTOR: google.protobuf.descriptor.Descriptor
+
+    TICKET_FIELD_NUMBER: builtins.int
+    STAGE_FIELD_NUMBER: builtins.int
+    TIMESTAMP_US_FIELD_NUMBER: builtins.int
+    STATUS_FIELD_NUMBER: builtins.int
+    WAIT_MS_FIELD_NUMBER: builtins.int
+    FRAME_ID_FIELD_NUMBER: builtins.int
+    ticket: builtins.int
+    stage: global___DisplayStage.ValueType
+    timestamp_us: builtins.int
+    """UNIX 時刻 (マイクロ秒)"""
+    status: global___Status.ValueType
+    """DONE のみ"""
+    wait_ms: builtins.int
+    """DONE のみ: 受信から表示開始 (または破棄) までの待ち時間"""
+    frame_id: builtins.int
+    """DONE のみ: 表示中のフレームの ID (DataResponse と同じ)"""
+    def __init__(
+        self,
+        *,
+        ticket: builtins.int = ...,
+        stage: global___DisplayStage.ValueType = ...,
+        timestamp_us: builtins.int = ...,
+        status: global___Status.ValueType = ...,
+        wait_ms: builtins.int = ...,
+        frame_id: builtins.int = ...,
+    ) -> None: ...
+    def ClearField(self, field_name: typing.Literal["frame_id", b"frame_id", "stage", b"stage", "status", b"status", "ticket", b"ticket", "timestamp_us", b"timestamp_us", "wait_ms", b"wait_ms"]) -> None: ...
+
+global___DisplayEvent = DisplayEvent
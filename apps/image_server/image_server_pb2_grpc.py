@@ -40,6 +40,31 @@ class DataServiceStub(object):
                 request_serializer=image__server__pb2.DataRequest.SerializeToString,
                 response_deserializer=image__server__pb2.DataResponse.FromString,
                 _registered_method=True)
+        self.SubmitData = channel.unary_unary(
+                '/image_server.DataService/SubmitData',
+                request_serializer=image__server__pb2.DataRequest.SerializeToString,
+                response_deserializer=image__server__pb2.SubmitResponse.FromString,
+                _registered_method=True)
+        self.WatchDisplay = channel.unary_stream(
+                '/image_server.DataService/WatchDisplay',
+                request_serializer=image__server__pb2.WatchRequest.SerializeToString,
+                response_deserializer=image__server__pb2.DisplayEvent.FromString,
+                _registered_method=True)
+        self.UploadFrame = channel.stream_unary(
+                '/image_server.DataService/UploadFrame',
+                request_serializer=image__server__pb2.FrameChunk.SerializeToString,
+                response_deserializer=image__server__pb2.DataResponse.FromString,
+                _registered_method=True)
+        self.DisplayCached = channel.unary_unary(
+                '/image_server.DataService/DisplayCached',
+                request_serializer=image__server__pb2.CachedRequest.SerializeToString,
+                response_deserializer=image__server__pb2.DataResponse.FromString,
+                _registered_method=True)
+        self.SetPlaylist = channel.unary_unary(
+                '/image_server.DataService/SetPlaylist',
+                request_serializer=image__server__pb2.Playlist.SerializeToString,
+                response_deserializer=image__server__pb2.PlaylistResponse.FromString,
+                _registered_method=True)
 
 
 class DataServiceServicer(object):
@@ -52,6 +77,41 @@ class DataServiceServicer(object):
         context.set_details('Method not implemented!')
         raise NotImplementedError('Method not implemented!')
 
+    def SubmitData(self, request, context):
+        """受け付けた時点でチケットを返し、表示の完了は待たない
+        """
+        context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+        context.set_details('Method not implemented!')
+        raise NotImplementedError('Method not implemented!')
+
+    def WatchDisplay(self, request, context):
+        """チケットの進捗イベントを配信する。個別のチケットは DONE で終了する
+        """
+        context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+        context.set_details('Method not implemented!')
+        raise NotImplementedError('Method not implemented!')
+
+    def UploadFrame(self, request_iterator, context):
+        """断片を受け取りながらパネルへ転送する。受信と SPI 転送が並行して進む
+        """
+        context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+        context.set_details('Method not implemented!')
+        raise NotImplementedError('Method not implemented!')
+
+    def DisplayCached(self, request, context):
+        """表示したことのあるフレームを、サーバーのキャッシュから ID だけで表示する
+        """
+        context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+        context.set_details('Method not implemented!')
+        raise NotImplementedError('Method not implemented!')
+
+    def SetPlaylist(self, request, context):
+        """スライドショーを置き換え、新しいプレイリストの最初から表示する
+        """
+        context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+        context.set_details('Method not implemented!')
+        raise NotImplementedError('Method not implemented!')
+
 
 def add_DataServiceServicer_to_server(servicer, server):
     rpc_method_handlers = {
@@ -60,6 +120,31 @@ def add_DataServiceServicer_to_server(servicer, server):
                     request_deserializer=image__server__pb2.DataRequest.FromString,
                     response_serializer=image__server__pb2.DataResponse.SerializeToString,
             ),
+            'SubmitData': grpc.unary_unary_rpc_method_handler(
+                    servicer.SubmitData,
+                    request_deserializer=image__server__pb2.DataRequest.FromString,
+                    response_serializer=image__server__pb2.SubmitResponse.SerializeToString,
+            ),
+            'WatchDisplay': grpc.unary_stream_rpc_method_handler(
+                    servicer.WatchDisplay,
+                    request_deserializer=image__server__pb2.WatchRequest.FromString,
+                    response_serializer=image__server__pb2.DisplayEvent.SerializeToString,
+            ),
+            'UploadFrame': grpc.stream_unary_rpc_method_handler(
+                    servicer.UploadFrame,
+                    request_deserializer=image__server__pb2.FrameChunk.FromString,
+                    response_serializer=image__server__pb2.DataResponse.SerializeToString,
+            ),
+            'DisplayCached': grpc.unary_unary_rpc_method_handler(
+                    servicer.DisplayCached,
+                    request_deserializer=image__server__pb2.CachedRequest.FromString,
+                    response_serializer=image__server__pb2.DataResponse.SerializeToString,
+            ),
+            'SetPlaylist': grpc.unary_unary_rpc_method_handler(
+                    servicer.SetPlaylist,
+                    request_deserializer=image__server__pb2.Playlist.FromString,
+                    response_serializer=image__server__pb2.PlaylistResponse.SerializeToString,
+            ),
     }
     generic_handler = grpc.method_handlers_generic_handler(
             'image_server.DataService', rpc_method_handlers)
@@ -98,3 +183,138 @@ class DataService(object):
             timeout,
             metadata,
             _registered_method=True)
+
+    @staticmethod
+    def SubmitData(request,
+            target,
+            options=(),
+            channel_credentials=None,
+            call_credentials=None,
+            insecure=False,
+            compression=None,
+            wait_for_ready=None,
+            timeout=None,
+            metadata=None):
+        return grpc.experimental.unary_unary(
+            request,
+            target,
+            '/image_server.DataService/SubmitData',
+            image__server__pb2.DataRequest.SerializeToString,
+            image__server__pb2.SubmitResponse.FromString,
+            options,
+            channel_credentials,
+            insecure,
+            call_credentials,
+            compression,
+            wait_for_ready,
+            timeout,
+            metadata,
+            _registered_method=True)
+
+    @staticmethod
+    def WatchDisplay(request,
+            target,
+            options=(),
+            channel_credentials=None,
+            call_credentials=None,
+            insecure=False,
+            compression=None,
+            wait_for_ready=None,
+            timeout=None,
+            metadata=None):
+        return grpc.experimental.unary_stream(
+            request,
+            target,
+            '/image_server.DataService/WatchDisplay',
+            image__server__pb2.WatchRequest.SerializeToString,
+            image__server__pb2.DisplayEvent.FromString,
+            options,
+            channel_credentials,
+            insecure,
+            call_credentials,
+            compression,
+            wait_for_ready,
+            timeout,
+            metadata,
+            _registered_method=True)
+
+    @staticmethod
+    def UploadFrame(request_iterator,
+            target,
+            options=(),
+            channel_credentials=None,
+            call_credentials=None,
+            insecure=False,
+            compression=None,
+            wait_for_ready=None,
+            timeout=None,
+            metadata=None):
+        return grpc.experimental.stream_unary(
+            request_iterator,
+            target,
+            '/image_server.DataService/UploadFrame',
+            image__server__pb2.FrameChunk.SerializeToString,
+            image__server__pb2.DataResponse.FromString,
+            options,
+            channel_credentials,
+            insecure,
+            call_credentials,
+            compression,
+            wait_for_ready,
+            timeout,
+            metadata,
+            _registered_method=True)
+
+    @staticmethod
+    def DisplayCached(request,
+            target,
+            options=(),
+            channel_credentials=None,
+            call_credentials=None,
+            insecure=False,
+            compression=None,
+            wait_for_ready=None,
+            timeout=None,
+            metadata=None):
+        return grpc.experimental.unary_unary(
+            request,
+            target,
+            '/image_server.DataService/DisplayCached',
+            image__server__pb2.CachedRequest.SerializeToString,
+            image__server__pb2.DataResponse.FromString,
+            options,
+            channel_credentials,
+            insecure,
+            call_credentials,
+            compression,
+            wait_for_ready,
+            timeout,
+            metadata,
+            _registered_method=True)
+
+    @staticmethod
+    def SetPlaylist(request,
+            target,
+            options=(),
+            channel_credentials=None,
+            call_credentials=None,
+            insecure=False,
+            compression=None,
+            wait_for_ready=None,
+            timeout=None,
+            metadata=None):
+        return grpc.experimental.unary_unary(
+            request,
+            target,
+            '/image_server.DataService/SetPlaylist',
+            image__server__pb2.Playlist.SerializeToString,
+            image__server__pb2.PlaylistResponse.FromString,
+            options,
+            channel_credentials,
+            insecure,
+            call_credentials,
+            compression,
+            wait_for_ready,
+            timeout,
+            metadata,
+            _registered_method=True)
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <string>
+#include <system_error>
+#include <vector>
+
+// Copy of the frame on the glass, kept on disk so a restarted server knows what the panel shows
+// (the panel keeps its image through deep sleep and reset).
+class LastFrameStore {
+ public:
+  explicit LastFrameStore(std::filesystem::path path) : path_(std::move(path)) {}
+
+  // Location from IMAGE_SERVER_LAST_FRAME, defaulting to last_frame.bin in the working directory.
+  static auto from_environment() -> LastFrameStore {
+    const char* path = std::getenv("IMAGE_SERVER_LAST_FRAME");
+    return LastFrameStore(path != nullptr ? path : "last_frame.bin");
+  }
+
+  [[nodiscard]] auto load(size_t expected_size) const -> std::optional<std::vector<uint8_t>> {
+    std::error_code ec;
+    if (std::filesystem::file_size(path_, ec) != expected_size || ec) {
+      return std::nullopt;
+    }
+    std::vector<uint8_t> frame(expected_size);
+    std::ifstream file(path_, std::ios::binary);
+    if (!file.read(reinterpret_cast<char*>(frame.data()),
+                   static_cast<std::streamsize>(frame.size()))) {
+      return std::nullopt;
+    }
+    return frame;
+  }
+
+  // Writes through a temporary file and rename() so a crash never leaves a torn frame behind.
+  auto store(std::span<const uint8_t> frame) const -> void {
+    const auto tmp = std::filesystem::path(path_).concat(".tmp");
+    {
+      std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+      file.write(reinterpret_cast<const char*>(frame.data()),
+                 static_cast<std::streamsize>(frame.size()));
+      if (!file.flush()) {
+        std::cerr << "Failed to write " << tmp << std::endl;
+        return;
+      }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path_, ec);
+    if (ec) {
+      std::cerr << "Failed to store last frame: " << ec.message() << std::endl;
+    }
+  }
+
+ private:
+  std::filesystem::path path_;
+};
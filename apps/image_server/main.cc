@@ -1,58 +1,781 @@
 #include <grpcpp/grpcpp.h>
+#include <signal.h>
 
-#include <iomanip>
+#define STB_IMAGE_IMPLEMENTATION
+#define STB_IMAGE_RESIZE2_IMPLEMENTATION
+#include <stb/stb_image.h>
+#include <stb/stb_image_resize2.h>
+
+#include <chrono>
+#include <deque>
+#include <exception>
+#include <expected>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
 #include <string>
+#include <thread>
 
-#include "epd_7in3e.hh"
+#include "chunked_frame.hh"
+#include "cron_window.hh"
+#include "display_queue.hh"
+#include "epd_driver.hh"
+#include "frame_cache.hh"
+#include "frame_codec.hh"
 #include "image_server.grpc.pb.h"
+#include "last_frame.hh"
+#include "rendered_frame.hh"
+#include "slideshow.hh"
 
 using grpc::Server;
+using grpc::ServerAsyncReader;
+using grpc::ServerAsyncResponseWriter;
+using grpc::ServerAsyncWriter;
 using grpc::ServerBuilder;
+using grpc::ServerCompletionQueue;
 using grpc::ServerContext;
-using grpc::Status;
 
+using image_server::CachedRequest;
 using image_server::DataRequest;
 using image_server::DataResponse;
 using image_server::DataService;
+using image_server::FrameChunk;
+using image_server::Playlist;
+using image_server::PlaylistResponse;
+using image_server::ProcessingSpec;
+using image_server::SubmitResponse;
+using image_server::WatchRequest;
 
-class DataServiceImpl final : public DataService::Service {
+// A tag on the completion queue.
+class Call {
  public:
-  ::grpc::Status SendData(ServerContext* context, const DataRequest* request,
-                          DataResponse* response) override {
-    const std::string& data = request->payload();
+  virtual ~Call() = default;
+  // Advances the call when its tag comes off the completion queue.
+  virtual void proceed(bool ok) = 0;
+};
+
+auto to_status(FrameOutcome outcome) -> image_server::Status {
+  switch (outcome) {
+    case FrameOutcome::DISPLAYED:
+    case FrameOutcome::SKIPPED:
+      return image_server::Status::OK;
+    case FrameOutcome::SUPERSEDED:
+      return image_server::Status::SUPERSEDED;
+    case FrameOutcome::EXPIRED:
+      return image_server::Status::EXPIRED;
+    case FrameOutcome::QUEUE_FULL:
+      return image_server::Status::QUEUE_FULL;
+    case FrameOutcome::FAILED:
+      break;
+  }
+  return image_server::Status::ERROR;
+}
+
+// Fills `response` for a frame that has completed; a failed frame becomes an RPC error instead.
+auto respond(const FrameResult& result, DataResponse& response) -> ::grpc::Status {
+  response.set_queue_depth(static_cast<uint32_t>(result.queue_depth));
+  response.set_wait_ms(static_cast<uint32_t>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(result.waited).count()));
+  response.set_frame_id(result.frame_id);
+  if (result.outcome != FrameOutcome::FAILED) {
+    response.set_status(to_status(result.outcome));
+    return ::grpc::Status::OK;
+  }
+  try {
+    if (result.error) {
+      std::rethrow_exception(result.error);
+    }
+    return {::grpc::StatusCode::UNAVAILABLE, "Frame was cancelled"};
+  } catch (const std::exception& e) {
+    return {::grpc::StatusCode::UNAVAILABLE, std::string("e-Paper failed: ") + e.what()};
+  }
+}
+
+struct Frame {
+  std::span<const uint8_t> pixels;
+  std::shared_ptr<const void> owner;  // keeps `pixels` alive
+  Epaper::RowProducer producer;       // set while `pixels` is still being rendered
+};
+
+// A request's visible_at_us; 0 for none.
+auto visible_at_of(int64_t visible_at_us) -> DisplayQueue::VisibleAt {
+  if (visible_at_us == 0) {
+    return std::nullopt;
+  }
+  return std::chrono::system_clock::time_point(std::chrono::microseconds(visible_at_us));
+}
+
+// Queues `frame` with the request's priority, TTL and target time, streaming it to the panel if
+// it is still being rendered.
+auto submit(DisplayQueue& display, Frame frame, const DataRequest& request,
+            DisplayQueue::Completion done) -> uint64_t {
+  const auto ttl = std::chrono::milliseconds(request.ttl_ms());
+  const auto visible_at = visible_at_of(request.visible_at_us());
+  if (frame.producer) {
+    return display.submit_stream(frame.pixels, std::move(frame.owner), std::move(frame.producer),
+                                 request.priority(), ttl, visible_at, std::move(done));
+  }
+  return display.submit(frame.pixels, std::move(frame.owner), request.priority(), ttl, visible_at,
+                        std::move(done));
+}
+
+auto render_spec_of(const ProcessingSpec& processing) -> RenderSpec {
+  RenderSpec spec;
+  // The enums list their values in the same order.
+  if (ProcessingSpec::Fit_IsValid(processing.fit())) {
+    spec.fit = static_cast<RenderSpec::Fit>(processing.fit());
+  }
+  if (ProcessingSpec::Dither_IsValid(processing.dither())) {
+    spec.dither = static_cast<RenderSpec::Dither>(processing.dither());
+  }
+  spec.exposure = processing.exposure();
+  if (processing.has_contrast()) {
+    spec.contrast = processing.contrast();
+  }
+  if (processing.has_saturation()) {
+    spec.saturation = processing.saturation();
+  }
+  return spec;
+}
 
-    if (data.size() != 800 * 480 / 2) {
-      response->set_status(image_server::Status::IMAGE_SIZE_MISMATCH);
-      return ::grpc::Status::OK;
+// Starts rendering an image file or RGB image into a frame. Only the header is checked here; the
+// decode and everything after it run on the renderer's threads, and the panel takes the rows as
+// they come.
+auto rendered_frame_of(const std::shared_ptr<const DataRequest>& request)
+    -> std::expected<Frame, image_server::Status> {
+  const std::string& data = request->payload();
+  ImageSource source{
+      .data = {reinterpret_cast<const uint8_t*>(data.data()), data.size()},
+      .owner = request,
+  };
+  if (request->encoding() == image_server::Encoding::RGB24) {
+    source.width = static_cast<int>(request->width());
+    source.height = static_cast<int>(request->height());
+    if (source.width == 0) {
+      return std::unexpected(image_server::Status::INVALID_IMAGE);
     }
+  }
+  if (!valid_source(source)) {
+    return std::unexpected(image_server::Status::INVALID_IMAGE);
+  }
+  auto frame = std::make_shared<RenderedFrame>(std::move(source),
+                                               render_spec_of(request->processing()));
+  return Frame{frame->frame(), frame, [frame](int row, std::span<uint8_t> packed_row) {
+                 frame->read_row(row, packed_row);
+                 return true;
+               }};
+}
 
-    // data to std::array<uint8_t, 800 * 480 / 2>
-    std::array<uint8_t, 800 * 480 / 2> buffer;
-    for (size_t i = 0; i < data.size(); ++i) {
-      buffer[i] = static_cast<uint8_t>(data[i]);
+// Rebuilds a delta frame from a copy of the frame on the glass; the copy keeps that one intact for
+// the frames queued meanwhile.
+auto delta_frame_of(const DataRequest& request, DisplayQueue& display)
+    -> std::expected<Frame, image_server::Status> {
+  auto frame = std::make_shared<std::vector<uint8_t>>(Epaper::EPD7IN3E::FRAME_BYTES);
+  if (!display.copy_displayed(request.base_frame_id(), *frame)) {
+    return std::unexpected(image_server::Status::BASE_MISMATCH);
+  }
+  for (const auto& range : request.delta()) {
+    const std::span bits(reinterpret_cast<const uint8_t*>(range.bits().data()),
+                         range.bits().size());
+    if (!Apps::Common::apply_xor(*frame, range.offset(), bits)) {
+      return std::unexpected(image_server::Status::IMAGE_SIZE_MISMATCH);
+    }
+  }
+  return Frame{*frame, frame};
+}
+
+// The request's frame in the panel's format: the raw payload itself, or the decoded, rebuilt or
+// rendered one. Fails when the payload does not hold exactly one frame or a readable image, or
+// the delta's base is gone.
+auto frame_of(const std::shared_ptr<const DataRequest>& request, DisplayQueue& display)
+    -> std::expected<Frame, image_server::Status> {
+  if (request->base_frame_id() != 0) {
+    return delta_frame_of(*request, display);
+  }
+  const std::string& data = request->payload();
+  const std::span payload(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+  switch (request->encoding()) {
+    case image_server::Encoding::RAW:
+      if (payload.size() != Epaper::EPD7IN3E::FRAME_BYTES) {
+        return std::unexpected(image_server::Status::IMAGE_SIZE_MISMATCH);
+      }
+      return Frame{payload, request};
+    case image_server::Encoding::BASE6_RLE: {
+      auto decoded = std::make_shared<std::vector<uint8_t>>(Epaper::EPD7IN3E::FRAME_BYTES);
+      if (!Apps::Common::decode_base6_rle(payload, *decoded)) {
+        return std::unexpected(image_server::Status::IMAGE_SIZE_MISMATCH);
+      }
+      return Frame{*decoded, decoded};
+    }
+    case image_server::Encoding::IMAGE:
+    case image_server::Encoding::RGB24:
+      return rendered_frame_of(request);
+    default:
+      return std::unexpected(image_server::Status::IMAGE_SIZE_MISMATCH);
+  }
+}
+
+// A slide's frame with every row rendered, so the refresh has nothing left to wait for.
+auto prepared_frame_of(const std::shared_ptr<const DataRequest>& image, DisplayQueue& display)
+    -> std::optional<PreparedFrame> {
+  auto frame = frame_of(image, display);
+  if (!frame) {
+    return std::nullopt;
+  }
+  if (frame->producer) {
+    std::vector<uint8_t> row(Epaper::EPD7IN3E::FRAME_BYTES / Epaper::EPD7IN3E::HEIGHT);
+    try {
+      for (int y = 0; y < Epaper::EPD7IN3E::HEIGHT; ++y) {
+        if (!frame->producer(y, row)) {
+          return std::nullopt;
+        }
+      }
+    } catch (const std::exception& e) {
+      std::cerr << "Slide failed to render: " << e.what() << std::endl;
+      return std::nullopt;
     }
-    epd7in3e_.display(buffer.data());
-    response->set_status(image_server::Status::OK);
-    return ::grpc::Status::OK;
+  }
+  return PreparedFrame{frame->pixels, std::move(frame->owner)};
+}
+
+// Whether a slide's image can be shown, checked without rendering it.
+auto image_status(const DataRequest& image) -> image_server::Status {
+  if (image.base_frame_id() != 0) {
+    return image_server::Status::INVALID_PLAYLIST;
+  }
+  const std::string& data = image.payload();
+  const std::span payload(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+  switch (image.encoding()) {
+    case image_server::Encoding::RAW:
+      return payload.size() == Epaper::EPD7IN3E::FRAME_BYTES
+                 ? image_server::Status::OK
+                 : image_server::Status::IMAGE_SIZE_MISMATCH;
+    case image_server::Encoding::BASE6_RLE: {
+      std::vector<uint8_t> decoded(Epaper::EPD7IN3E::FRAME_BYTES);
+      return Apps::Common::decode_base6_rle(payload, decoded)
+                 ? image_server::Status::OK
+                 : image_server::Status::IMAGE_SIZE_MISMATCH;
+    }
+    case image_server::Encoding::IMAGE:
+      return valid_source({.data = payload}) ? image_server::Status::OK
+                                             : image_server::Status::INVALID_IMAGE;
+    case image_server::Encoding::RGB24:
+      return image.width() != 0 && valid_source({.data = payload,
+                                                 .width = static_cast<int>(image.width()),
+                                                 .height = static_cast<int>(image.height())})
+                 ? image_server::Status::OK
+                 : image_server::Status::INVALID_IMAGE;
+    default:
+      return image_server::Status::IMAGE_SIZE_MISMATCH;
+  }
+}
+
+// One SendData call on the completion queue. Its frame is handed to the DisplayQueue, and the
+// response goes out when the frame is displayed or dropped, so no thread blocks on a refresh.
+class SendDataCall final : public Call {
+ public:
+  SendDataCall(DataService::AsyncService* service, ServerCompletionQueue* cq,
+               DisplayQueue* display)
+      : service_(service), cq_(cq), display_(display), responder_(&context_) {
+    service_->RequestSendData(&context_, request_.get(), &responder_, cq_, cq_, this);
+  }
+
+  void proceed(bool ok) override {
+    if (state_ == State::FINISHING || !ok) {
+      delete this;
+      return;
+    }
+
+    // Keep a call waiting for the next client before this one is processed.
+    new SendDataCall(service_, cq_, display_);
+
+    state_ = State::DISPLAYING;
+    auto frame = frame_of(request_, *display_);
+    if (!frame) {
+      response_.set_status(frame.error());
+      finish_(::grpc::Status::OK);
+      return;
+    }
+
+    // A raw payload goes from here to SPI as is, kept alive by the shared request until the
+    // driver is done with it; an encoded one is decoded once.
+    submit(*display_, std::move(*frame), *request_,
+           [this](const FrameResult& result) { finish_(respond(result, response_)); });
+  }
+
+ private:
+  enum class State { WAITING, DISPLAYING, FINISHING };
+
+  void finish_(const ::grpc::Status& status) {
+    state_ = State::FINISHING;
+    responder_.Finish(response_, status, this);
+  }
+
+  DataService::AsyncService* service_;
+  ServerCompletionQueue* cq_;
+  DisplayQueue* display_;
+
+  ServerContext context_;
+  std::shared_ptr<DataRequest> request_ = std::make_shared<DataRequest>();
+  DataResponse response_;
+  ServerAsyncResponseWriter<DataResponse> responder_;
+  State state_ = State::WAITING;
+};
+
+// One DisplayCached call. The frame is mapped from the FrameCache and goes to SPI straight from the
+// page cache, so a repeat costs the request and nothing else.
+class DisplayCachedCall final : public Call {
+ public:
+  DisplayCachedCall(DataService::AsyncService* service, ServerCompletionQueue* cq,
+                    DisplayQueue* display, FrameCache* cache)
+      : service_(service), cq_(cq), display_(display), cache_(cache), responder_(&context_) {
+    service_->RequestDisplayCached(&context_, &request_, &responder_, cq_, cq_, this);
+  }
+
+  void proceed(bool ok) override {
+    if (finishing_ || !ok) {
+      delete this;
+      return;
+    }
+
+    new DisplayCachedCall(service_, cq_, display_, cache_);
+
+    auto frame = cache_->open(request_.frame_id());
+    if (!frame || frame->data().size() != Epaper::EPD7IN3E::FRAME_BYTES) {
+      response_.set_status(image_server::Status::NOT_CACHED);
+      finish_(::grpc::Status::OK);
+      return;
+    }
+    // The mapping stays alive until the driver is done with it.
+    display_->submit(frame->data(), frame, request_.priority(),
+                     std::chrono::milliseconds(request_.ttl_ms()),
+                     visible_at_of(request_.visible_at_us()),
+                     [this](const FrameResult& result) { finish_(respond(result, response_)); });
   }
 
  private:
-  Epaper::EPD7IN3E epd7in3e_;
+  void finish_(const ::grpc::Status& status) {
+    finishing_ = true;
+    responder_.Finish(response_, status, this);
+  }
+
+  DataService::AsyncService* service_;
+  ServerCompletionQueue* cq_;
+  DisplayQueue* display_;
+  FrameCache* cache_;
+
+  ServerContext context_;
+  CachedRequest request_;
+  DataResponse response_;
+  ServerAsyncResponseWriter<DataResponse> responder_;
+  bool finishing_ = false;
+};
+
+// One SetPlaylist call. The playlist is checked here and handed to the Slideshow, which stores it
+// and renders the first slide on its own thread.
+class SetPlaylistCall final : public Call {
+ public:
+  SetPlaylistCall(DataService::AsyncService* service, ServerCompletionQueue* cq,
+                  Slideshow* slideshow)
+      : service_(service), cq_(cq), slideshow_(slideshow), responder_(&context_) {
+    service_->RequestSetPlaylist(&context_, &request_, &responder_, cq_, cq_, this);
+  }
+
+  void proceed(bool ok) override {
+    if (finishing_ || !ok) {
+      delete this;
+      return;
+    }
+
+    new SetPlaylistCall(service_, cq_, slideshow_);
+
+    finishing_ = true;
+    response_.set_status(image_server::Status::OK);
+    for (int i = 0; i < request_.entries_size(); ++i) {
+      const auto& entry = request_.entries(i);
+      auto status = image_status(entry.image());
+      if (entry.duration_s() == 0 || !CronWindow::parse(entry.window())) {
+        status = image_server::Status::INVALID_PLAYLIST;
+      }
+      if (status != image_server::Status::OK) {
+        response_.set_status(status);
+        response_.set_entry(static_cast<uint32_t>(i));
+        break;
+      }
+    }
+    if (response_.status() == image_server::Status::OK) {
+      slideshow_->replace(std::move(request_));
+    }
+    responder_.Finish(response_, ::grpc::Status::OK, this);
+  }
+
+ private:
+  DataService::AsyncService* service_;
+  ServerCompletionQueue* cq_;
+  Slideshow* slideshow_;
+
+  ServerContext context_;
+  Playlist request_;
+  PlaylistResponse response_;
+  ServerAsyncResponseWriter<PlaylistResponse> responder_;
+  bool finishing_ = false;
+};
+
+// One UploadFrame stream. The frame joins the queue with its first chunk; once it reaches the
+// panel, each row goes out over SPI as soon as its chunk is in, so a slow link and the upload
+// overlap. The response goes out when both the stream and the frame have ended.
+class UploadFrameCall final : public Call {
+ public:
+  UploadFrameCall(DataService::AsyncService* service, ServerCompletionQueue* cq,
+                  DisplayQueue* display)
+      : service_(service), cq_(cq), display_(display), reader_(&context_) {
+    service_->RequestUploadFrame(&context_, &reader_, cq_, cq_, this);
+  }
+
+  void proceed(bool ok) override {
+    std::unique_lock lock(mutex_);
+    switch (state_) {
+      case State::WAITING:
+        if (!ok) {
+          lock.unlock();
+          delete this;
+          return;
+        }
+        new UploadFrameCall(service_, cq_, display_);
+        state_ = State::READING;
+        break;
+      case State::READING:
+        if (!ok) {
+          // The client is done sending, or gone.
+          frame_->close();
+          state_ = State::READ_DONE;
+          finish_if_done_locked_();
+          return;
+        }
+        if (!frame_->append(chunk_.first_row(), chunk_.rows())) {
+          // Keep draining the stream, but the frame cannot complete any more.
+          frame_->close();
+          malformed_ = true;
+        } else if (!submitted_) {
+          submitted_ = true;
+          lock.unlock();
+          // Outside the lock: a frame rejected outright completes from within submit_stream().
+          submit_();
+        }
+        break;
+      case State::READ_DONE:
+        return;
+      case State::FINISHING:
+        lock.unlock();
+        delete this;
+        return;
+    }
+    reader_.Read(&chunk_, this);
+  }
+
+ private:
+  enum class State { WAITING, READING, READ_DONE, FINISHING };
+
+  void submit_() {
+    std::shared_ptr<ChunkedFrame> frame = frame_;
+    display_->submit_stream(
+        frame->frame(), frame,
+        [frame](int row, std::span<uint8_t> packed_row) {
+          frame->read_row(row, packed_row);
+          return true;
+        },
+        chunk_.priority(), std::chrono::milliseconds(chunk_.ttl_ms()), std::nullopt,
+        [this](const FrameResult& result) {
+          std::lock_guard lock(mutex_);
+          result_ = result;
+          if (frame_->expired()) {
+            // The panel gave up on the frame; stop the client sending the rest of it.
+            context_.TryCancel();
+          }
+          finish_if_done_locked_();
+        });
+  }
+
+  void finish_if_done_locked_() {
+    if (state_ != State::READ_DONE || (submitted_ && !result_)) {
+      return;
+    }
+    state_ = State::FINISHING;
+    if (malformed_ || !frame_->complete()) {
+      response_.set_status(image_server::Status::IMAGE_SIZE_MISMATCH);
+      reader_.Finish(response_, ::grpc::Status::OK, this);
+      return;
+    }
+    reader_.Finish(response_, respond(*result_, response_), this);
+  }
+
+  DataService::AsyncService* service_;
+  ServerCompletionQueue* cq_;
+  DisplayQueue* display_;
+
+  ServerContext context_;
+  ServerAsyncReader<DataResponse, FrameChunk> reader_;
+  FrameChunk chunk_;
+  std::shared_ptr<ChunkedFrame> frame_ = std::make_shared<ChunkedFrame>(
+      Epaper::Panel7in3e::ROW_BYTES, Epaper::Panel7in3e::HEIGHT);
+
+  std::mutex mutex_;  // the frame's completion arrives on the driver's worker
+  State state_ = State::WAITING;
+  bool submitted_ = false;
+  bool malformed_ = false;
+  std::optional<FrameResult> result_;
+  DataResponse response_;
+};
+
+// One SubmitData call: queues the frame and answers at once with its ticket. The outcome is
+// published on the DisplayQueue's events for WatchDisplay.
+class SubmitDataCall final : public Call {
+ public:
+  SubmitDataCall(DataService::AsyncService* service, ServerCompletionQueue* cq,
+                 DisplayQueue* display)
+      : service_(service), cq_(cq), display_(display), responder_(&context_) {
+    service_->RequestSubmitData(&context_, request_.get(), &responder_, cq_, cq_, this);
+  }
+
+  void proceed(bool ok) override {
+    if (finishing_ || !ok) {
+      delete this;
+      return;
+    }
+
+    new SubmitDataCall(service_, cq_, display_);
+
+    finishing_ = true;
+    if (auto frame = frame_of(request_, *display_)) {
+      // The frame outlives this call while it waits for the panel.
+      response_.set_ticket(
+          submit(*display_, std::move(*frame), *request_, [](const FrameResult&) {}));
+      response_.set_status(image_server::Status::OK);
+    } else {
+      response_.set_status(frame.error());
+    }
+    responder_.Finish(response_, ::grpc::Status::OK, this);
+  }
+
+ private:
+  DataService::AsyncService* service_;
+  ServerCompletionQueue* cq_;
+  DisplayQueue* display_;
+
+  ServerContext context_;
+  std::shared_ptr<DataRequest> request_ = std::make_shared<DataRequest>();
+  SubmitResponse response_;
+  ServerAsyncResponseWriter<SubmitResponse> responder_;
+  bool finishing_ = false;
+};
+
+// One WatchDisplay stream. Events arrive from the DisplayQueue on whatever thread publishes them
+// and wait in an outbox, since the stream allows one write in flight. The call is deleted once
+// both its last tag and the done notification have come off the completion queue.
+class WatchDisplayCall final : public Call {
+ public:
+  WatchDisplayCall(DataService::AsyncService* service, ServerCompletionQueue* cq,
+                   DisplayQueue* display)
+      : service_(service), cq_(cq), display_(display), writer_(&context_), done_(this) {
+    context_.AsyncNotifyWhenDone(&done_);
+    service_->RequestWatchDisplay(&context_, &request_, &writer_, cq_, cq_, this);
+  }
+
+  ~WatchDisplayCall() override {
+    if (subscription_) {
+      display_->events().unsubscribe(*subscription_);
+    }
+  }
+
+  void proceed(bool ok) override {
+    if (!started_) {
+      if (!ok) {
+        // Never started, so the done notification never comes.
+        delete this;
+        return;
+      }
+      started_ = true;
+      new WatchDisplayCall(service_, cq_, display_);
+      subscribe_();
+      return;
+    }
+
+    std::unique_lock lock(mutex_);
+    if (finishing_) {
+      finished_ = true;
+      if (done_seen_) {
+        lock.unlock();
+        delete this;
+      }
+      return;
+    }
+    writing_ = false;
+    if (!ok) {
+      // The client went away; nothing more can be written.
+      outbox_.clear();
+      ending_ = true;
+    }
+    write_next_locked_();
+  }
+
+ private:
+  // Tag for AsyncNotifyWhenDone(), which comes off the queue separately from the stream's own.
+  class DoneTag final : public Call {
+   public:
+    explicit DoneTag(WatchDisplayCall* call) : call_(call) {}
+    void proceed(bool /*ok*/) override { call_->on_done_(); }
+
+   private:
+    WatchDisplayCall* call_;
+  };
+
+  void subscribe_() {
+    const auto ticket = request_.ticket();
+    subscription_ = display_->events().subscribe(
+        ticket, [this](const DisplayEvent& event) { enqueue_(event); }, [this] { end_(); });
+    if (!subscription_) {
+      std::lock_guard lock(mutex_);
+      if (!ending_) {
+        status_ = {::grpc::StatusCode::NOT_FOUND, "Unknown ticket"};
+        ending_ = true;
+      }
+      write_next_locked_();
+    }
+  }
+
+  void enqueue_(const DisplayEvent& event) {
+    std::lock_guard lock(mutex_);
+    if (ending_) {
+      return;
+    }
+    image_server::DisplayEvent& message = outbox_.emplace_back();
+    message.set_ticket(event.ticket);
+    message.set_stage(static_cast<image_server::DisplayStage>(event.stage));
+    message.set_timestamp_us(std::chrono::duration_cast<std::chrono::microseconds>(
+                                 event.time.time_since_epoch())
+                                 .count());
+    if (event.stage == DisplayStage::DONE) {
+      message.set_status(to_status(event.result.outcome));
+      message.set_wait_ms(static_cast<uint32_t>(
+          std::chrono::duration_cast<std::chrono::milliseconds>(event.result.waited).count()));
+      message.set_frame_id(event.result.frame_id);
+      // A single ticket's stream ends with its outcome.
+      ending_ = request_.ticket() != 0;
+    }
+    write_next_locked_();
+  }
+
+  void end_() {
+    std::lock_guard lock(mutex_);
+    ending_ = true;
+    write_next_locked_();
+  }
+
+  void on_done_() {
+    std::unique_lock lock(mutex_);
+    done_seen_ = true;
+    if (finished_) {
+      lock.unlock();
+      delete this;
+      return;
+    }
+    // Cancelled by the client: stop queueing and finish once the write in flight returns.
+    outbox_.clear();
+    ending_ = true;
+    write_next_locked_();
+  }
+
+  void write_next_locked_() {
+    if (writing_ || finishing_) {
+      return;
+    }
+    if (!outbox_.empty()) {
+      writing_ = true;
+      current_ = std::move(outbox_.front());
+      outbox_.pop_front();
+      writer_.Write(current_, this);
+    } else if (ending_) {
+      finishing_ = true;
+      writer_.Finish(status_, this);
+    }
+  }
+
+  DataService::AsyncService* service_;
+  ServerCompletionQueue* cq_;
+  DisplayQueue* display_;
+
+  ServerContext context_;
+  WatchRequest request_;
+  ServerAsyncWriter<image_server::DisplayEvent> writer_;
+  DoneTag done_;
+  bool started_ = false;
+  std::optional<uint64_t> subscription_;
+
+  std::mutex mutex_;
+  std::deque<image_server::DisplayEvent> outbox_;
+  image_server::DisplayEvent current_;  // the write in flight
+  ::grpc::Status status_ = ::grpc::Status::OK;
+  bool writing_ = false;
+  bool ending_ = false;     // finish once the outbox drains
+  bool finishing_ = false;  // Finish() issued
+  bool finished_ = false;   // Finish() completed
+  bool done_seen_ = false;
 };
 
 int main() {
+  // SIGINT/SIGTERM shut the server down cleanly so the driver can put the panel to sleep.
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGINT);
+  sigaddset(&signals, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
   const std::string server_address("0.0.0.0:50051");
-  DataServiceImpl service;
+  FrameCache cache = FrameCache::from_environment();
+  DisplayQueue display(LastFrameStore::from_environment(), cache);
+  Slideshow slideshow(PlaylistStore::from_environment(), display,
+                      [&display](const Slideshow::Image& image) {
+                        return prepared_frame_of(image, display);
+                      });
+  DataService::AsyncService service;
 
   ServerBuilder builder;
   builder.AddChannelArgument(GRPC_ARG_ALLOW_REUSEPORT, 0);
+  // Photos and raw RGB images run past gRPC's 4 MB default.
+  builder.SetMaxReceiveMessageSize(64 * 1024 * 1024);
   builder.AddListeningPort(server_address, grpc::InsecureServerCredentials());
   builder.RegisterService(&service);
+  std::unique_ptr<ServerCompletionQueue> cq = builder.AddCompletionQueue();
 
   std::unique_ptr<Server> server(builder.BuildAndStart());
   std::cout << "Server listening on " << server_address << std::endl;
-  server->Wait();
+
+  // Every call has to be completed before the server can shut down, so the panel goes first, after
+  // the slideshow that feeds it: that finishes the refresh in progress, fails the queued frames and
+  // ends the event streams.
+  std::thread signal_thread([&] {
+    int signal = 0;
+    sigwait(&signals, &signal);
+    std::cout << "Shutting down" << std::endl;
+    slideshow.shutdown();
+    display.shutdown();
+    server->Shutdown();
+    cq->Shutdown();
+  });
+
+  new SendDataCall(&service, cq.get(), &display);
+  new SubmitDataCall(&service, cq.get(), &display);
+  new WatchDisplayCall(&service, cq.get(), &display);
+  new UploadFrameCall(&service, cq.get(), &display);
+  new DisplayCachedCall(&service, cq.get(), &display, &cache);
+  new SetPlaylistCall(&service, cq.get(), &slideshow);
+  void* tag = nullptr;
+  bool ok = false;
+  while (cq->Next(&tag, &ok)) {
+    static_cast<Call*>(tag)->proceed(ok);
+  }
+  signal_thread.join();
   return 0;
 }
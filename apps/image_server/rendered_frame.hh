@@ -0,0 +1,372 @@
+#pragma once
+
+#include <stb/stb_image.h>
+#include <stb/stb_image_resize2.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <barrier>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "color_palette.hh"
+#include "epd_panels.hh"
+
+// How an image becomes a panel frame: fitted to the panel, adjusted, then dithered to its colours.
+struct RenderSpec {
+  enum class Fit : uint8_t {
+    COVER,    // keep the aspect ratio, fill the panel and crop the overflow
+    CONTAIN,  // keep the aspect ratio, fit inside the panel on white
+    STRETCH,  // fill the panel, ignoring the aspect ratio
+  };
+  enum class Dither : uint8_t { FLOYD_STEINBERG, ATKINSON, NONE };
+
+  Fit fit = Fit::COVER;
+  Dither dither = Dither::FLOYD_STEINBERG;
+  float exposure = 0.f;    // EV
+  float contrast = 1.f;    // around mid grey; 1 leaves it unchanged
+  float saturation = 1.f;  // 1 leaves it unchanged
+};
+
+// An image file (JPEG, PNG, BMP, ...) when `width` is 0, otherwise `width` x `height` 24-bit RGB.
+struct ImageSource {
+  std::span<const uint8_t> data;
+  int width = 0;
+  int height = 0;
+  std::shared_ptr<const void> owner;  // keeps `data` alive
+};
+
+// Largest image taken, at 3 bytes per pixel once decoded.
+inline constexpr int64_t MAX_SOURCE_PIXELS = 24'000'000;
+
+// Whether `source` can be rendered: a file whose header stb_image reads, or RGB data of exactly the
+// stated size, within MAX_SOURCE_PIXELS. Only looks at the header, so it is cheap enough for the
+// RPC thread.
+inline auto valid_source(const ImageSource& source) -> bool {
+  int width = source.width;
+  int height = source.height;
+  if (width == 0) {
+    int channels = 0;
+    if (source.data.size() > INT_MAX ||
+        stbi_info_from_memory(source.data.data(), static_cast<int>(source.data.size()), &width,
+                              &height, &channels) == 0) {
+      return false;
+    }
+  } else if (width < 0 || height <= 0 ||
+             source.data.size() != static_cast<size_t>(width) * static_cast<size_t>(height) * 3) {
+    return false;
+  }
+  return width > 0 && height > 0 && int64_t{width} * height <= MAX_SOURCE_PIXELS;
+}
+
+// A frame rendered from an image on a few threads. One decodes, all of them resize a band each,
+// then they dither as a wavefront: each thread takes every Nth row, a few pixels behind the row
+// above so the error that row diffuses downwards is final by the time it is read. Rows can be read
+// as soon as they are done, so the SPI upload follows the dithering the way it follows the network
+// for a ChunkedFrame.
+class RenderedFrame {
+ public:
+  using Panel = Epaper::Panel7in3e;
+
+  explicit RenderedFrame(ImageSource source, RenderSpec spec,
+                         unsigned threads = std::thread::hardware_concurrency())
+      : source_(std::move(source)),
+        spec_(spec),
+        threads_(static_cast<int>(std::clamp(threads, 1U, static_cast<unsigned>(HEIGHT)))),
+        canvas_(static_cast<size_t>(WIDTH) * HEIGHT * 3),
+        error_(static_cast<size_t>(ERROR_STRIDE) * (HEIGHT + 2)),
+        packed_(Panel::FRAME_BYTES),
+        progress_(HEIGHT),
+        stage_(threads_),
+        start_(std::chrono::steady_clock::now()) {
+    build_tone_();
+    workers_.reserve(static_cast<size_t>(threads_));
+    for (int i = 0; i < threads_; ++i) {
+      workers_.emplace_back([this, i](std::stop_token stop) { work_(stop, i); });
+    }
+  }
+
+  // Threads still dithering give up at their next row; the members wait for them.
+  ~RenderedFrame() {
+    for (auto& worker : workers_) {
+      worker.request_stop();
+    }
+  }
+
+  RenderedFrame(const RenderedFrame&) = delete;
+  auto operator=(const RenderedFrame&) -> RenderedFrame& = delete;
+
+  // The whole frame, valid once every row has been read.
+  [[nodiscard]] auto frame() const -> std::span<const uint8_t> { return packed_; }
+
+  // Copies packed row `row` into `out`, waiting for it to be dithered. Throws if the image could
+  // not be decoded.
+  void read_row(int row, std::span<uint8_t> out) {
+    wait_for_(row, WIDTH);
+    if (failure_) {
+      std::rethrow_exception(failure_);
+    }
+    std::ranges::copy_n(packed_.begin() + static_cast<ptrdiff_t>(row * Panel::ROW_BYTES),
+                        static_cast<ptrdiff_t>(Panel::ROW_BYTES), out.begin());
+  }
+
+ private:
+  static constexpr int WIDTH = Panel::WIDTH;
+  static constexpr int HEIGHT = Panel::HEIGHT;
+  // Furthest any kernel pushes error sideways; the error rows are padded by this much.
+  static constexpr int REACH = 2;
+  static constexpr int ERROR_STRIDE = (WIDTH + 2 * REACH) * 3;
+  // Pixels dithered between progress updates, trading wavefront lag for fewer wake-ups.
+  static constexpr int BLOCK = 32;
+
+  struct Tap {
+    int dx, dy, weight;
+  };
+  // Error-diffusion kernel: weights in 1 / (1 << shift).
+  struct Kernel {
+    std::span<const Tap> taps;
+    int shift;
+  };
+  static constexpr std::array<Tap, 4> FLOYD_STEINBERG{
+      {{1, 0, 7}, {-1, 1, 3}, {0, 1, 5}, {1, 1, 1}}};
+  static constexpr std::array<Tap, 6> ATKINSON{
+      {{1, 0, 1}, {2, 0, 1}, {-1, 1, 1}, {0, 1, 1}, {1, 1, 1}, {0, 2, 1}}};
+
+  [[nodiscard]] auto kernel_() const -> Kernel {
+    switch (spec_.dither) {
+      case RenderSpec::Dither::FLOYD_STEINBERG:
+        return {FLOYD_STEINBERG, 4};
+      case RenderSpec::Dither::ATKINSON:
+        return {ATKINSON, 3};
+      case RenderSpec::Dither::NONE:
+        break;
+    }
+    return {{}, 0};
+  }
+
+  // Exposure and contrast act on each channel alone, so they fold into one table.
+  void build_tone_() {
+    const float gain = std::exp2(spec_.exposure);
+    for (size_t v = 0; v < tone_.size(); ++v) {
+      tone_[v] = ((static_cast<float>(v) / 255.f * gain - 0.5f) * spec_.contrast + 0.5f) * 255.f;
+    }
+    identity_ = spec_.exposure == 0.f && spec_.contrast == 1.f && spec_.saturation == 1.f;
+  }
+
+  void work_(const std::stop_token& stop, int index) {
+    if (index == 0) {
+      prepare_();
+    }
+    stage_.arrive_and_wait();
+    if (!failure_ && index < splits_) {
+      stbir_resize_extended_split(&resize_, index, 1);
+    }
+    stage_.arrive_and_wait();
+    if (index == 0) {
+      release_source_();
+    }
+
+    for (int row = index; row < HEIGHT; row += threads_) {
+      // Rows given up on still count as done, so no thread waits on them.
+      if (failure_ || stop.stop_requested()) {
+        publish_(row, WIDTH);
+        continue;
+      }
+      dither_row_(row);
+    }
+  }
+
+  // Decodes the source if needed and sets up the resize, split across the threads.
+  void prepare_() {
+    try {
+      const uint8_t* pixels = source_.data.data();
+      int width = source_.width;
+      int height = source_.height;
+      if (width == 0) {
+        int channels = 0;
+        decoded_ = stbi_load_from_memory(pixels, static_cast<int>(source_.data.size()), &width,
+                                         &height, &channels, 3);
+        if (decoded_ == nullptr) {
+          throw std::runtime_error(std::string("Failed to decode image: ") +
+                                   stbi_failure_reason());
+        }
+        pixels = decoded_;
+      }
+      source_width_ = width;
+      source_height_ = height;
+      fit_(pixels, width, height);
+      splits_ = stbir_build_samplers_with_splits(&resize_, threads_);
+      if (splits_ == 0) {
+        throw std::runtime_error("Failed to set up the resize");
+      }
+    } catch (...) {
+      failure_ = std::current_exception();
+    }
+  }
+
+  // Points the resize at the part of the source that shows and the part of the canvas it covers.
+  void fit_(const uint8_t* pixels, int width, int height) {
+    const double source_aspect = static_cast<double>(width) / height;
+    const double panel_aspect = static_cast<double>(WIDTH) / HEIGHT;
+    int out_x = 0;
+    int out_y = 0;
+    int out_width = WIDTH;
+    int out_height = HEIGHT;
+    if (spec_.fit == RenderSpec::Fit::CONTAIN) {
+      std::ranges::fill(canvas_, 255);
+      if (source_aspect > panel_aspect) {
+        out_height = std::max(1, static_cast<int>(std::lround(WIDTH / source_aspect)));
+      } else {
+        out_width = std::max(1, static_cast<int>(std::lround(HEIGHT * source_aspect)));
+      }
+      out_x = (WIDTH - out_width) / 2;
+      out_y = (HEIGHT - out_height) / 2;
+    }
+
+    stbir_resize_init(&resize_, pixels, width, height, 0,
+                      canvas_.data() + (static_cast<size_t>(out_y) * WIDTH + out_x) * 3, out_width,
+                      out_height, WIDTH * 3, STBIR_RGB, STBIR_TYPE_UINT8);
+    if (spec_.fit == RenderSpec::Fit::COVER) {
+      if (source_aspect > panel_aspect) {
+        const double shown = panel_aspect / source_aspect;
+        stbir_set_input_subrect(&resize_, (1 - shown) / 2, 0, (1 + shown) / 2, 1);
+      } else {
+        const double shown = source_aspect / panel_aspect;
+        stbir_set_input_subrect(&resize_, 0, (1 - shown) / 2, 1, (1 + shown) / 2);
+      }
+    }
+  }
+
+  void release_source_() {
+    if (splits_ != 0) {
+      stbir_free_samplers(&resize_);
+    }
+    if (decoded_ != nullptr) {
+      stbi_image_free(decoded_);
+      decoded_ = nullptr;
+    }
+    source_.owner.reset();
+  }
+
+  // Adjusted colours of canvas row `row`, before any diffused error.
+  void adjust_row_(int row, std::span<int, WIDTH * 3> out) const {
+    const uint8_t* in = canvas_.data() + static_cast<size_t>(row) * WIDTH * 3;
+    if (identity_) {
+      std::ranges::copy(std::span(in, out.size()), out.begin());
+      return;
+    }
+    for (size_t i = 0; i < out.size(); i += 3) {
+      float r = tone_[in[i]];
+      float g = tone_[in[i + 1]];
+      float b = tone_[in[i + 2]];
+      const float gray = 0.2126f * r + 0.7152f * g + 0.0722f * b;  // Rec.709
+      r = gray + (r - gray) * spec_.saturation;
+      g = gray + (g - gray) * spec_.saturation;
+      b = gray + (b - gray) * spec_.saturation;
+      out[i] = static_cast<int>(std::lround(std::clamp(r, 0.f, 255.f)));
+      out[i + 1] = static_cast<int>(std::lround(std::clamp(g, 0.f, 255.f)));
+      out[i + 2] = static_cast<int>(std::lround(std::clamp(b, 0.f, 255.f)));
+    }
+  }
+
+  auto error_at_(int row, int x) -> int16_t* {
+    return error_.data() + static_cast<size_t>(row) * ERROR_STRIDE +
+           static_cast<size_t>(x + REACH) * 3;
+  }
+
+  void dither_row_(int row) {
+    std::array<int, WIDTH * 3> adjusted;
+    adjust_row_(row, adjusted);
+    const Kernel kernel = kernel_();
+    const int round = kernel.shift == 0 ? 0 : 1 << (kernel.shift - 1);
+    std::array<uint8_t, WIDTH> colors;
+
+    for (int block = 0; block < WIDTH; block += BLOCK) {
+      const int end = std::min(block + BLOCK, WIDTH);
+      // The row above has to be past everything this block reads or writes in it.
+      if (row > 0) {
+        wait_for_(row - 1, std::min(end + 2 * REACH, WIDTH));
+      }
+      for (int x = block; x < end; ++x) {
+        const int* base = &adjusted[static_cast<size_t>(x) * 3];
+        const int16_t* carried = error_at_(row, x);
+        std::array<int, 3> value;
+        for (size_t c = 0; c < 3; ++c) {
+          value[c] = std::clamp(base[c] + ((carried[c] + round) >> kernel.shift), 0, 255);
+        }
+        const auto& [color, rgb] =
+            Apps::Common::closest_palette_entry(value[0], value[1], value[2]);
+        colors[static_cast<size_t>(x)] = static_cast<uint8_t>(color);
+        for (const auto& tap : kernel.taps) {
+          int16_t* target = error_at_(row + tap.dy, x + tap.dx);
+          for (size_t c = 0; c < 3; ++c) {
+            target[c] = static_cast<int16_t>(target[c] + (value[c] - rgb[c]) * tap.weight);
+          }
+        }
+      }
+      if (end < WIDTH) {
+        publish_(row, end);
+      }
+    }
+
+    Epaper::pack_pixels<Panel>(
+        colors, std::span(packed_).subspan(static_cast<size_t>(row) * Panel::ROW_BYTES,
+                                           Panel::ROW_BYTES));
+    publish_(row, WIDTH);
+    if (row == HEIGHT - 1) {
+      std::cout << "Rendered " << source_width_ << "x" << source_height_ << " image in "
+                << std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::steady_clock::now() - start_)
+                       .count()
+                << " ms on " << threads_ << " threads" << std::endl;
+    }
+  }
+
+  // Pixels [0, done) of `row` are dithered; WIDTH once the row is also packed.
+  void publish_(int row, int done) {
+    auto& progress = progress_[static_cast<size_t>(row)];
+    progress.store(done, std::memory_order_release);
+    progress.notify_all();
+  }
+
+  void wait_for_(int row, int done) {
+    auto& progress = progress_[static_cast<size_t>(row)];
+    for (int seen = progress.load(std::memory_order_acquire); seen < done;
+         seen = progress.load(std::memory_order_acquire)) {
+      progress.wait(seen, std::memory_order_acquire);
+    }
+  }
+
+  ImageSource source_;
+  const RenderSpec spec_;
+  const int threads_;
+  std::array<float, 256> tone_{};
+  bool identity_ = true;
+
+  // Written by the first thread before the stage barrier, read-only after it.
+  stbi_uc* decoded_ = nullptr;
+  STBIR_RESIZE resize_{};
+  int splits_ = 0;
+  int source_width_ = 0;
+  int source_height_ = 0;
+  std::exception_ptr failure_;
+
+  std::vector<uint8_t> canvas_;   // the fitted image, WIDTH x HEIGHT RGB
+  std::vector<int16_t> error_;    // error diffused into each pixel, in kernel units
+  std::vector<uint8_t> packed_;
+  std::vector<std::atomic<int>> progress_;  // per row, see publish_()
+  std::barrier<> stage_;
+  const std::chrono::steady_clock::time_point start_;
+  std::vector<std::jthread> workers_;  // last, so they are joined before the rest goes
+};
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <span>
+#include <stop_token>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "cron_window.hh"
+#include "display_queue.hh"
+#include "image_server.pb.h"
+
+// The playlist on disk, so the slideshow carries on after a restart. Images and all, it is written
+// only when the playlist changes.
+class PlaylistStore {
+ public:
+  explicit PlaylistStore(std::filesystem::path path) : path_(std::move(path)) {}
+
+  // Location from IMAGE_SERVER_PLAYLIST, defaulting to playlist.pb in the working directory.
+  static auto from_environment() -> PlaylistStore {
+    const char* path = std::getenv("IMAGE_SERVER_PLAYLIST");
+    return PlaylistStore(path != nullptr ? path : "playlist.pb");
+  }
+
+  // An empty playlist if there is none or it cannot be read.
+  [[nodiscard]] auto load() const -> image_server::Playlist {
+    image_server::Playlist playlist;
+    std::ifstream file(path_, std::ios::binary);
+    if (file && !playlist.ParseFromIstream(&file)) {
+      std::cerr << "Ignoring unreadable playlist " << path_ << std::endl;
+      playlist.Clear();
+    }
+    return playlist;
+  }
+
+  // Writes through a temporary file and rename() like LastFrameStore.
+  void store(const image_server::Playlist& playlist) const {
+    const auto tmp = std::filesystem::path(path_).concat(".tmp");
+    {
+      std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+      if (!playlist.SerializeToOstream(&file) || !file.flush()) {
+        std::cerr << "Failed to write " << tmp << std::endl;
+        return;
+      }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path_, ec);
+    if (ec) {
+      std::cerr << "Failed to store playlist: " << ec.message() << std::endl;
+    }
+  }
+
+ private:
+  std::filesystem::path path_;
+};
+
+// A packed frame ready for the panel.
+struct PreparedFrame {
+  std::span<const uint8_t> pixels;
+  std::shared_ptr<const void> owner;  // keeps `pixels` alive
+};
+
+// Shows the playlist's images in turn, each for its duration and only inside its window. Runs on
+// its own thread, which renders the next image while the current one is up and hands it to the
+// DisplayQueue at its start time, so the refresh starts on schedule whatever the decode and dither
+// cost. Slides go through the queue like any other frame, at the playlist's priority.
+class Slideshow {
+ public:
+  using Clock = std::chrono::system_clock;
+  using Image = std::shared_ptr<const image_server::DataRequest>;
+  // Renders a slide's image completely; nothing if it cannot be.
+  using Render = std::function<std::optional<PreparedFrame>(const Image&)>;
+
+  // Resumes the stored playlist. `display` must outlive the slideshow.
+  Slideshow(PlaylistStore store, DisplayQueue& display, Render render)
+      : store_(std::move(store)),
+        display_(display),
+        render_(std::move(render)),
+        incoming_(store_.load()),
+        thread_([this](std::stop_token stop) { run_(stop); }) {}
+
+  Slideshow(const Slideshow&) = delete;
+  auto operator=(const Slideshow&) -> Slideshow& = delete;
+
+  // Stops the slideshow. A slide still rendering is finished first but not shown.
+  void shutdown() {
+    thread_.request_stop();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  // Replaces the playlist and starts it from the top; an empty one stops the slideshow. The
+  // entries must have been checked: durations above zero, valid windows.
+  void replace(image_server::Playlist playlist) {
+    {
+      std::lock_guard lock(mutex_);
+      incoming_ = std::move(playlist);
+      store_incoming_ = true;
+    }
+    cv_.notify_all();
+  }
+
+ private:
+  struct Slide {
+    Image image;
+    std::chrono::seconds duration;
+    CronWindow window;
+  };
+
+  void run_(const std::stop_token& stop) {
+    std::unique_lock lock(mutex_);
+    auto due = Clock::now();
+    while (!stop.stop_requested()) {
+      if (incoming_) {
+        take_incoming_(lock);
+        due = Clock::now();
+        continue;
+      }
+      if (slides_.empty()) {
+        cv_.wait(lock, stop, [this] { return incoming_.has_value(); });
+        continue;
+      }
+
+      const auto index = pick_(due);
+      if (!index) {
+        // Nothing is in its window then; windows open on the minute.
+        due = std::chrono::ceil<std::chrono::minutes>(due + std::chrono::seconds(1));
+        cv_.wait_until(lock, stop, due, [this] { return incoming_.has_value(); });
+        continue;
+      }
+      const Slide slide = slides_[*index];
+
+      lock.unlock();
+      auto frame = render_(slide.image);
+      lock.lock();
+      if (!frame) {
+        // It would fail the same way every round.
+        std::cerr << "Dropping slide " << *index << ", its image cannot be rendered" << std::endl;
+        drop_(*index);
+        continue;
+      }
+      if (cv_.wait_until(lock, stop, due, [this] { return incoming_.has_value(); }) ||
+          stop.stop_requested()) {
+        continue;
+      }
+
+      // A slide that was late, say because its image took longer to render than the one before it
+      // was up, still gets its full duration.
+      const auto shown = std::max(due, Clock::now());
+      lock.unlock();
+      display_.submit(frame->pixels, std::move(frame->owner), priority_, {}, std::nullopt,
+                      [](const FrameResult&) {});
+      lock.lock();
+      due = shown + slide.duration;
+    }
+  }
+
+  // Swaps in the new playlist, storing it first if it came from replace().
+  void take_incoming_(std::unique_lock<std::mutex>& lock) {
+    auto playlist = std::move(*incoming_);
+    incoming_.reset();
+    const bool store = std::exchange(store_incoming_, false);
+    lock.unlock();
+    if (store) {
+      store_.store(playlist);
+    }
+    std::vector<Slide> slides;
+    slides.reserve(static_cast<size_t>(playlist.entries_size()));
+    for (int i = 0; i < playlist.entries_size(); ++i) {
+      auto& entry = *playlist.mutable_entries(i);
+      auto window = CronWindow::parse(entry.window());
+      if (!window || entry.duration_s() == 0) {
+        std::cerr << "Skipping invalid playlist entry " << i << std::endl;
+        continue;
+      }
+      slides.push_back({
+          .image = std::make_shared<const image_server::DataRequest>(
+              std::move(*entry.mutable_image())),
+          .duration = std::chrono::seconds(entry.duration_s()),
+          .window = *window,
+      });
+    }
+    std::cout << "Playlist of " << slides.size() << " slides" << std::endl;
+    lock.lock();
+
+    slides_ = std::move(slides);
+    shuffle_ = playlist.shuffle();
+    priority_ = playlist.priority();
+    order_.resize(slides_.size());
+    std::iota(order_.begin(), order_.end(), size_t{0});
+    next_ = order_.size();  // so the first pick shuffles
+  }
+
+  // The next slide in order whose window contains `at`, going round at most once.
+  auto pick_(Clock::time_point at) -> std::optional<size_t> {
+    for (size_t tried = 0; tried < order_.size(); ++tried) {
+      if (next_ == order_.size()) {
+        next_ = 0;
+        if (shuffle_) {
+          std::ranges::shuffle(order_, random_);
+        }
+      }
+      const size_t index = order_[next_++];
+      if (slides_[index].window.contains(at)) {
+        return index;
+      }
+    }
+    return std::nullopt;
+  }
+
+  // Takes slide `index` out of the rotation.
+  void drop_(size_t index) {
+    const auto it = std::ranges::find(order_, index);
+    if (it - order_.begin() < static_cast<ptrdiff_t>(next_)) {
+      --next_;
+    }
+    order_.erase(it);
+  }
+
+  const PlaylistStore store_;
+  DisplayQueue& display_;
+  const Render render_;
+
+  std::mutex mutex_;
+  std::condition_variable_any cv_;
+  std::optional<image_server::Playlist> incoming_;  // waiting to be taken by the thread
+  bool store_incoming_ = false;
+  std::vector<Slide> slides_;
+  std::vector<size_t> order_;  // slides_ in rotation, shuffled each round if shuffle_
+  size_t next_ = 0;            // position in order_
+  bool shuffle_ = false;
+  uint32_t priority_ = 0;
+  std::mt19937 random_{std::random_device{}()};
+
+  std::jthread thread_;  // last, so it is joined before the rest goes
+};
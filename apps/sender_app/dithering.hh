@@ -1,58 +1,21 @@
 #pragma once
 
 #include <algorithm>
-#include <cmath>
-#include <map>
-#include <ranges>
+#include <stdexcept>
 #include <vector>
 
-enum class EPDColor {
-  BLACK = 0x00,
-  WHITE = 0x01,
-  YELLOW = 0x02,
-  RED = 0x03,
-  BLUE = 0x05,
-  GREEN = 0x06,
-};
+#include "color_palette.hh"
 
-const std::map<EPDColor, std::array<uint8_t, 3>> PALETTE = {
-    {EPDColor::BLACK, {0, 0, 0}},       //
-    {EPDColor::WHITE, {255, 255, 255}}, //
-    {EPDColor::YELLOW, {255, 255, 0}},  //
-    {EPDColor::RED, {255, 0, 0}},       //
-    {EPDColor::BLUE, {0, 0, 255}},      //
-    {EPDColor::GREEN, {0, 255, 0}},     //
-};
+using Apps::Common::EPDColor;
 
 [[nodiscard]] inline auto closest_epd_color(const std::uint8_t *rgb)
     -> EPDColor {
-  double min_dist = std::numeric_limits<double>::max();
-  EPDColor closest = EPDColor::BLACK;
-  for (const auto &[color, val] : PALETTE) {
-    double dist = 0.0;
-    for (int i = 0; i < 3; ++i) {
-      dist += std::pow(rgb[i] - val[i], 2);
-    }
-    if (dist < min_dist) {
-      min_dist = dist;
-      closest = color;
-    }
-  }
-  return closest;
+  return Apps::Common::closest_color(rgb);
 }
 
 inline auto nearest_color(const std::array<uint8_t, 3> &c)
     -> std::array<uint8_t, 3> {
-  int best_d = 1 << 30;
-  std::array<uint8_t, 3> best = {};
-  for (const auto &p : PALETTE | std::views::values) {
-    int dr = int(c[0]) - p[0], dg = int(c[1]) - p[1], db = int(c[2]) - p[2];
-    int d = dr * dr + dg * dg + db * db;
-    if (d < best_d) {
-      best_d = d, best = p;
-    }
-  }
-  return best;
+  return Apps::Common::closest_palette_entry(c[0], c[1], c[2]).second;
 }
 
 [[nodiscard]]
@@ -1,6 +1,10 @@
+#include "frame_codec.hh"
 #include "image_server.grpc.pb.h"
 #include <grpcpp/grpcpp.h>
 
+#include <functional>
+#include <mutex>
+
 //---------------------------------------------------------------------
 //  gRPC image sender (blocking)
 //---------------------------------------------------------------------
@@ -10,18 +14,138 @@ public:
       : stub_(image_server::DataService::NewStub(std::move(channel))) {}
 
   void Send(const std::vector<std::uint8_t> &payload) {
-    image_server::DataRequest req;
-    req.set_payload(payload.data(), payload.size());
-
     image_server::DataResponse resp;
+    for (bool delta : {true, false}) {
+      image_server::DataRequest req;
+      SetFrame(req, payload, delta);
+      grpc::ClientContext ctx;
+
+      resp.Clear();
+      grpc::Status status = stub_->SendData(&ctx, req, &resp);
+      if (!status.ok()) {
+        throw std::runtime_error("gRPC failed: " + status.error_message());
+      }
+      // On BASE_MISMATCH the server no longer has our base; send it whole.
+      if (resp.status() != image_server::Status::BASE_MISMATCH) {
+        break;
+      }
+    }
+    Acknowledge(payload, resp.frame_id());
+  }
+
+  // Queues the frame and returns its ticket without waiting for the refresh.
+  std::uint64_t Submit(const std::vector<std::uint8_t> &payload,
+                       std::uint32_t priority = 0, std::uint32_t ttl_ms = 0) {
+    image_server::SubmitResponse resp;
+    for (bool delta : {true, false}) {
+      image_server::DataRequest req;
+      SetFrame(req, payload, delta);
+      req.set_priority(priority);
+      req.set_ttl_ms(ttl_ms);
+      grpc::ClientContext ctx;
+
+      resp.Clear();
+      grpc::Status status = stub_->SubmitData(&ctx, req, &resp);
+      if (!status.ok()) {
+        throw std::runtime_error("gRPC failed: " + status.error_message());
+      }
+      if (resp.status() != image_server::Status::BASE_MISMATCH) {
+        break;
+      }
+    }
+    if (resp.status() != image_server::Status::OK) {
+      throw std::runtime_error("Frame rejected: " +
+                               image_server::Status_Name(resp.status()));
+    }
+    std::lock_guard lock(base_mutex_);
+    submitted_ = payload;
+    submitted_ticket_ = resp.ticket();
+    return resp.ticket();
+  }
+
+  // Blocks until the ticket is done, passing each progress event to
+  // `on_event`. Returns the final status.
+  image_server::Status
+  Watch(std::uint64_t ticket,
+        const std::function<void(const image_server::DisplayEvent &)>
+            &on_event) {
+    image_server::WatchRequest req;
+    req.set_ticket(ticket);
     grpc::ClientContext ctx;
 
-    grpc::Status status = stub_->SendData(&ctx, req, &resp);
+    auto reader = stub_->WatchDisplay(&ctx, req);
+    image_server::DisplayEvent event;
+    image_server::Status result = image_server::Status::ERROR;
+    while (reader->Read(&event)) {
+      on_event(event);
+      if (event.stage() == image_server::DisplayStage::DONE) {
+        result = event.status();
+        std::unique_lock lock(base_mutex_);
+        if (event.ticket() == submitted_ticket_) {
+          auto frame = std::move(submitted_);
+          submitted_ticket_ = 0;
+          lock.unlock();
+          Acknowledge(frame, event.frame_id());
+        }
+      }
+    }
+    grpc::Status status = reader->Finish();
     if (!status.ok()) {
       throw std::runtime_error("gRPC failed: " + status.error_message());
     }
+    return result;
   }
 
 private:
+  // Sends the frame BASE6_RLE-encoded, or raw if it has other colours. With
+  // `allow_delta`, only the bytes changed since the frame the server last
+  // reported on the glass go out instead, when that is smaller.
+  void SetFrame(image_server::DataRequest &req,
+                const std::vector<std::uint8_t> &payload, bool allow_delta) {
+    if (auto encoded = Apps::Common::encode_base6_rle(payload)) {
+      req.set_payload(encoded->data(), encoded->size());
+      req.set_encoding(image_server::Encoding::BASE6_RLE);
+    } else {
+      req.set_payload(payload.data(), payload.size());
+    }
+    if (!allow_delta) {
+      return;
+    }
+
+    std::lock_guard lock(base_mutex_);
+    if (base_id_ == 0 || base_frame_.size() != payload.size()) {
+      return;
+    }
+    image_server::DataRequest delta;
+    for (const auto &range : Apps::Common::diff_frames(base_frame_, payload)) {
+      auto *out = delta.add_delta();
+      out->set_offset(static_cast<std::uint32_t>(range.offset));
+      out->set_bits(range.bits.data(), range.bits.size());
+    }
+    if (delta.ByteSizeLong() < req.payload().size()) {
+      req.clear_payload();
+      req.clear_encoding();
+      req.set_base_frame_id(base_id_);
+      req.mutable_delta()->Swap(delta.mutable_delta());
+    }
+  }
+
+  // `frame` is on the glass as `frame_id` (0 if it did not get there).
+  void Acknowledge(const std::vector<std::uint8_t> &frame,
+                   std::uint64_t frame_id) {
+    if (frame_id == 0) {
+      return;
+    }
+    std::lock_guard lock(base_mutex_);
+    base_frame_ = frame;
+    base_id_ = frame_id;
+  }
+
   std::unique_ptr<image_server::DataService::Stub> stub_;
+
+  std::mutex base_mutex_;
+  std::vector<std::uint8_t> base_frame_; // base for delta frames
+  std::uint64_t base_id_ = 0;
+  std::vector<std::uint8_t> submitted_; // awaiting its DONE event
+  std::uint64_t submitted_ticket_ = 0;
 };
@@ -1,4 +1,5 @@
 #include <QApplication>
+#include <QDebug>
 #include <QLabel>
 #include <QPainter>
 #include <QPushButton>
@@ -175,10 +176,18 @@ public slots:
                         (static_cast<std::uint8_t>(c1) << 4));
     }
 
-    auto client = std::make_shared<ImageClient>(grpc::CreateChannel(
-        "192.168.1.101:50051", grpc::InsecureChannelCredentials()));
-    future_ = QtConcurrent::run(
-        [p = std::move(payload), client] { client->Send(p); });
+    // One client across sends, so it can send deltas against the last frame.
+    if (!client_) {
+      client_ = std::make_shared<ImageClient>(grpc::CreateChannel(
+          "192.168.1.101:50051", grpc::InsecureChannelCredentials()));
+    }
+    future_ = QtConcurrent::run([p = std::move(payload), client = client_] {
+      const auto ticket = client->Submit(p);
+      client->Watch(ticket, [](const image_server::DisplayEvent &event) {
+        qDebug() << "frame" << event.ticket()
+                 << image_server::DisplayStage_Name(event.stage()).c_str();
+      });
+    });
   }
 
 protected:
@@ -209,6 +218,7 @@ private:
   int height_;
   std::vector<uint8_t> scaled_buffer_;
   std::vector<uint8_t> buffer_;
+  std::shared_ptr<ImageClient> client_;
   QFuture<void> future_;
 };
 
@@ -8,7 +8,9 @@
 #include <thread>
 #include <vector>
 
-#include "epd_7in3e.hh"
+#include "epd_driver.hh"
+
+using Panel = Epaper::Panel7in3e;
 
 struct RGB {
   uint8_t r, g, b;
@@ -46,69 +48,53 @@ auto load_bmp(const std::string &filename, int &width, int &height) -> std::vect
   return image;
 }
 
-auto convert_to_buffer(const std::vector<RGB> &pixels) -> std::vector<uint8_t> {
-  std::vector<uint8_t> ids;
-  ids.reserve(pixels.size());
-
-  for (const auto &px : pixels) {
-    int best_id = -1;
-    int min_dist_sq = std::numeric_limits<int>::max();
+auto closest_color_id(const RGB &px) -> uint8_t {
+  uint8_t best_id = 0;
+  int min_dist_sq = std::numeric_limits<int>::max();
 
-    for (const auto &[id, ref] : color_palette) {
-      int dr = static_cast<int>(px.r) - ref.r;
-      int dg = static_cast<int>(px.g) - ref.g;
-      int db = static_cast<int>(px.b) - ref.b;
-      int dist_sq = dr * dr + dg * dg + db * db;
+  for (const auto &[id, ref] : color_palette) {
+    int dr = static_cast<int>(px.r) - ref.r;
+    int dg = static_cast<int>(px.g) - ref.g;
+    int db = static_cast<int>(px.b) - ref.b;
+    int dist_sq = dr * dr + dg * dg + db * db;
 
-      if (dist_sq < min_dist_sq) {
-        min_dist_sq = dist_sq;
-        best_id = id;
-      }
+    if (dist_sq < min_dist_sq) {
+      min_dist_sq = dist_sq;
+      best_id = id;
     }
-
-    ids.push_back(best_id);
   }
-  std::vector<uint8_t> buffer;
+  return best_id;
+}
 
-  buffer.reserve(pixels.size() / 2);
-  for (size_t i = 0; i < ids.size(); i += 2) {
-    uint8_t first = ids[i];
-    uint8_t second = (i + 1 < ids.size()) ? ids[i + 1] : 0x00;  // Default to black if odd count
-    buffer.push_back(static_cast<uint8_t>((first << 4) | second));
+// Converts one row of `pixels` (Panel::WIDTH wide) into the packed row `out`.
+auto convert_row(const std::vector<RGB> &pixels, int row, std::span<uint8_t> out) -> void {
+  std::array<uint8_t, Panel::WIDTH> ids;
+  const auto *src = pixels.data() + static_cast<size_t>(row) * Panel::WIDTH;
+  for (int x = 0; x < Panel::WIDTH; ++x) {
+    ids[x] = closest_color_id(src[x]);
   }
-  return buffer;
+  Epaper::pack_pixels<Panel>(ids, out);
 }
 
-constexpr int WIDTH = 800;
-constexpr int HEIGHT = 480;
+constexpr int WIDTH = Panel::WIDTH;
+constexpr int HEIGHT = Panel::HEIGHT;
 
 std::vector<uint8_t> fill_segmented_screen() {
-  const int pixels_per_byte = 2;
-  const int total_pixels = WIDTH * HEIGHT;
-  const int total_bytes = total_pixels / pixels_per_byte;
-
-  std::vector<uint8_t> buffer(total_bytes, 0);
+  std::vector<uint8_t> buffer(Panel::FRAME_BYTES, 0);
 
   const int num_segments = 6;
   const int segment_width = WIDTH / num_segments;
-  const uint8_t colors[num_segments] = {0x0, 0x1, 0x2, 0x3, 0x5, 0x6};
+  const Panel::Color colors[num_segments] = {
+      Panel::Color::BLACK, Panel::Color::WHITE, Panel::Color::YELLOW,
+      Panel::Color::RED,   Panel::Color::BLUE,  Panel::Color::GREEN,
+  };
 
   for (int y = 0; y < HEIGHT; ++y) {
     for (int x = 0; x < WIDTH; ++x) {
       int segment = x / segment_width;
       if (segment >= num_segments) segment = num_segments - 1;
 
-      uint8_t color = colors[segment] & 0xF;
-      int pixel_index = y * WIDTH + x;
-      int byte_index = pixel_index / 2;
-
-      if (pixel_index % 2 == 0) {
-        buffer[byte_index] &= 0x0F;          // 下位4bitは残す
-        buffer[byte_index] |= (color << 4);  // 上位4bitに書き込み
-      } else {
-        buffer[byte_index] &= 0xF0;   // 上位4bitは残す
-        buffer[byte_index] |= color;  // 下位4bitに書き込み
-      }
+      Epaper::set_pixel<Panel>(buffer, x, y, colors[segment]);
     }
   }
 
@@ -133,15 +119,16 @@ class EpaperDevice {
   }
 
   auto test() -> void {
+    image_buffer_.resize(Panel::FRAME_BYTES);
     int counter = 0;
     for (auto &&i : image_buffer_) {
       auto color = static_cast<uint8_t>(counter++ % 7);
       if (color > 3) {
         color += 1;
       }
-      i = static_cast<uint8_t>(color << 4 | color);  // Fill with some pattern
+      i = Epaper::fill_byte<Panel>(static_cast<Panel::Color>(color));  // Fill with some pattern
     }
-    epd7in3e_.display(image_buffer_.data());
+    epd7in3e_.display(image_buffer_);
   }
 
   auto draw_image() -> void {
@@ -150,13 +137,17 @@ class EpaperDevice {
     std::println("BMP file size: {}", data.size());
     std::println("BMP file dimensions: {}x{}", width, height);
 
-    if (width != 800 || height != 480) {
+    if (width != WIDTH || height != HEIGHT) {
       throw std::runtime_error("Image dimensions do not match e-Paper display size.");
     }
 
-    epd7in3e_.display(convert_to_buffer(data).data());
+    // Rows are converted while the previous ones are already going out over SPI.
+    epd7in3e_.display_stream([&](int row, std::span<uint8_t> out) {
+      convert_row(data, row, out);
+      return true;
+    });
 
-    // epd7in3e_.display(fill_segmented_screen().data());
+    // epd7in3e_.display(fill_segmented_screen());
   }
 };
 
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <stdexcept>
+
+namespace Epaper {
+
+/// One controller command with its parameter bytes, sent as a single command byte followed by a
+/// single data burst.
+struct Command {
+  static constexpr size_t MAX_PAYLOAD = 6;
+
+  uint8_t code = 0;
+  uint8_t length = 0;
+  std::array<uint8_t, MAX_PAYLOAD> payload{};
+  /// Pause after the payload, for controllers that need settling time without signalling BUSY.
+  std::chrono::milliseconds delay{0};
+  /// Wait for the controller to release BUSY before the next command.
+  bool wait_busy = false;
+
+  [[nodiscard]] constexpr auto data() const -> std::span<const uint8_t> {
+    return {payload.data(), length};
+  }
+};
+
+/// Builds a table entry; an oversized payload fails to compile.
+consteval auto command(uint8_t code, std::initializer_list<uint8_t> payload = {},
+                       std::chrono::milliseconds delay = std::chrono::milliseconds{0},
+                       bool wait_busy = false) -> Command {
+  if (payload.size() > Command::MAX_PAYLOAD) {
+    throw std::length_error("Command payload too long");
+  }
+  Command result{.code = code,
+                 .length = static_cast<uint8_t>(payload.size()),
+                 .payload = {},
+                 .delay = delay,
+                 .wait_busy = wait_busy};
+  size_t i = 0;
+  for (const auto byte : payload) {
+    result.payload[i++] = byte;
+  }
+  return result;
+}
+
+/// Same as command() with a BUSY wait afterwards.
+consteval auto command_wait(uint8_t code, std::initializer_list<uint8_t> payload = {}) -> Command {
+  return command(code, payload, std::chrono::milliseconds{0}, true);
+}
+
+using CommandTable = std::span<const Command>;
+
+};  // namespace Epaper
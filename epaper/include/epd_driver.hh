@@ -0,0 +1,263 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "epd_command_table.hh"
+#include "epd_panels.hh"
+#include "epd_timing.hh"
+#include "epd_transport.hh"
+
+namespace Epaper {
+
+enum class DisplayOutcome : uint8_t {
+  DISPLAYED,  /*!< Uploaded and refreshed */
+  SKIPPED,    /*!< Identical to the frame already on the panel; nothing was sent */
+  SUPERSEDED, /*!< Replaced by a newer frame before its upload started */
+  CANCELLED,  /*!< Dropped by cancel_pending() or driver shutdown */
+  FAILED,     /*!< The transport threw; see DisplayResult::error */
+};
+
+struct DisplayResult {
+  DisplayOutcome outcome = DisplayOutcome::DISPLAYED;
+  std::chrono::nanoseconds queued{};  // submission until the worker picked the frame up
+  CallReport report{};                // phases of the display call; empty unless it ran
+  std::exception_ptr error{};
+};
+
+using DisplayCallback = std::function<void(const DisplayResult &)>;
+
+/// Called as each phase of a panel operation starts, e.g. to report upload and refresh progress.
+using PhaseObserver = std::function<void(Operation operation, Phase phase)>;
+
+/// Fills `packed_row` with row `row` of the frame in the panel's pixel format. Returning false
+/// aborts the frame before anything is refreshed.
+using RowProducer = std::function<bool(int row, std::span<uint8_t> packed_row)>;
+
+enum class PowerState : uint8_t {
+  OFF,   /*!< Configured, booster off */
+  ON,    /*!< Booster on, ready to refresh */
+  SLEEP, /*!< Deep sleep; needs a reset and the init sequence */
+};
+
+enum class IdleAction : uint8_t { POWER_OFF, DEEP_SLEEP };
+
+/// What the destructor leaves on the glass.
+enum class ShutdownPolicy : uint8_t {
+  CLEAR, /*!< Refresh to white, then deep sleep */
+  SLEEP, /*!< Keep the current image and go straight to deep sleep */
+};
+
+/// What happens to panel power after a refresh.
+struct PowerPolicy {
+  /// Keep the booster on this long after a refresh so back-to-back frames skip POWER_ON and
+  /// POWER_OFF. Zero powers down right after each refresh.
+  std::chrono::milliseconds hold{0};
+  /// Applied when the hold expires (or immediately with a zero hold).
+  IdleAction idle_action = IdleAction::POWER_OFF;
+};
+
+/// Driver for one panel family. `Panel` supplies geometry, pixel format, palette and the controller
+/// command tables (see epd_panels.hh); the instantiations live in epd_driver.cc.
+template <typename Panel>
+class EPDDriver {
+ private:
+  // A full colour refresh holds BUSY for 15-35 s.
+  static constexpr std::chrono::milliseconds BUSY_TIMEOUT = 60s;
+  // display_stream() hands rows to the uploader in blocks of this many.
+  static constexpr int STREAM_BLOCK_ROWS = 16;
+  std::unique_ptr<Transport> transport_;
+
+  double upload_bytes_per_second_ = 0.0;
+
+  // Hash of the frame on the glass; empty when unknown (after init or a failed refresh).
+  std::optional<uint64_t> displayed_hash_;
+  bool skip_identical_ = true;
+
+  ShutdownPolicy shutdown_policy_ = ShutdownPolicy::CLEAR;
+  PowerPolicy power_policy_;
+  PowerState power_state_ = PowerState::OFF;
+
+  PhaseRecorder phase_stats_;
+  PhaseObserver phase_observer_;
+  CallReport report_;  // call in progress, guarded by device_mutex_
+  std::array<CallReport, OPERATION_COUNT> last_reports_;
+
+  struct PendingFrame {
+    std::span<const uint8_t> image;
+    std::shared_ptr<const void> owner;  // keeps `image` alive until the frame completes
+    RowProducer producer;               // set instead of `image` by display_stream_async()
+    std::promise<DisplayResult> promise;
+    DisplayCallback on_complete;
+    std::chrono::steady_clock::time_point submitted;
+  };
+
+  // Held for every panel operation so display(), clear() and the worker never interleave.
+  std::mutex device_mutex_;
+
+  // At most one frame waits for the worker; a newer submission replaces it.
+  std::mutex pending_mutex_;
+  std::condition_variable_any pending_cv_;
+  std::optional<PendingFrame> pending_;
+  // When the worker should drop panel power; set after a refresh under a non-zero hold.
+  std::optional<std::chrono::steady_clock::time_point> idle_deadline_;
+  std::jthread worker_;
+
+ public:
+  using Color = typename Panel::Color;
+  static constexpr int WIDTH = Panel::WIDTH;
+  static constexpr int HEIGHT = Panel::HEIGHT;
+  static constexpr size_t FRAME_BYTES = Panel::FRAME_BYTES;
+
+  EPDDriver();
+  /// Panel wired to `pins`, on the backend chosen by make_transport().
+  explicit EPDDriver(const PinConfig &pins);
+  explicit EPDDriver(std::unique_ptr<Transport> transport);
+  ~EPDDriver();
+
+  EPDDriver(const EPDDriver &) = delete;
+  auto operator=(const EPDDriver &) -> EPDDriver & = delete;
+
+  auto clear(Color color) -> void;
+  /// Uploads and refreshes `image` (FRAME_BYTES, packed) on the calling thread. The buffer is
+  /// sent as is, without a copy.
+  auto display(std::span<const uint8_t> image) -> DisplayResult;
+
+  /// Calls `producer` for rows 0..HEIGHT-1 on the calling thread while a helper thread uploads the
+  /// finished rows, so producing the frame (e.g. dithering) overlaps the SPI transfer. An aborted
+  /// frame completes as CANCELLED and leaves the glass untouched. A frame that turns out to be on
+  /// the glass already completes as SKIPPED after the upload, without a refresh.
+  auto display_stream(const RowProducer &producer) -> DisplayResult;
+
+  /// Queues a copy of `image` for the driver's worker thread and returns immediately. A frame
+  /// still waiting for its upload is completed as SUPERSEDED. `on_complete` runs just before the
+  /// future becomes ready: on the worker for a frame it takes, otherwise on the thread that
+  /// supersedes or cancels the frame, before that call returns.
+  auto display_async(std::span<const uint8_t> image, DisplayCallback on_complete = {})
+      -> std::future<DisplayResult>;
+  /// Same without the copy: `image` must stay valid while `owner` is alive, and the driver holds
+  /// `owner` until the frame completes.
+  auto display_async(std::span<const uint8_t> image, std::shared_ptr<const void> owner,
+                     DisplayCallback on_complete = {}) -> std::future<DisplayResult>;
+  /// display_stream() on the worker thread, queued like display_async(). `producer` may block
+  /// until its rows arrive, e.g. from the network; the panel stays locked meanwhile.
+  auto display_stream_async(RowProducer producer, DisplayCallback on_complete = {})
+      -> std::future<DisplayResult>;
+
+  /// Drops the frame waiting for the worker, if any. Returns whether one was dropped.
+  auto cancel_pending() -> bool;
+
+  auto set_shutdown_policy(ShutdownPolicy policy) -> void;
+
+  auto set_power_policy(PowerPolicy policy) -> void;
+  [[nodiscard]] auto power_state() -> PowerState;
+
+  /// When enabled (the default), a frame whose hash matches the one on the panel completes as
+  /// SKIPPED without touching SPI or refreshing.
+  auto set_skip_identical(bool enabled) -> void;
+  /// Forgets what is on the panel so the next frame is always refreshed.
+  auto invalidate_displayed() -> void;
+  [[nodiscard]] auto displayed_hash() -> std::optional<uint64_t>;
+  /// Declares what is already on the glass, e.g. a frame persisted by a previous process.
+  auto set_displayed_hash(uint64_t hash) -> void;
+
+  /// Runs on the thread driving the panel, with the panel locked; it must not call back into the
+  /// driver.
+  auto set_phase_observer(PhaseObserver observer) -> void;
+
+  /// Phase timeline of the most recent completed call of `operation`.
+  [[nodiscard]] auto last_report(Operation operation) -> CallReport;
+  /// Running min/avg/max/p99 per phase across all calls.
+  [[nodiscard]] auto phase_stats() const -> std::array<PhaseStats, PHASE_COUNT> {
+    return phase_stats_.snapshot();
+  }
+
+  /// Throughput of the last panel RAM upload, measured around the SPI burst.
+  [[nodiscard]] auto upload_bytes_per_second() const -> double { return upload_bytes_per_second_; }
+
+  /// Readable when the panel may have left BUSY; lets an epoll loop track refresh completion.
+  [[nodiscard]] auto busy_fd() const -> int { return transport_->busy_fd(); }
+  [[nodiscard]] auto is_busy() -> bool { return transport_->is_busy(); }
+
+ private:
+  auto device_send_command_(uint8_t command) -> void;
+
+  auto device_send_data_(const uint8_t *data, size_t length) -> void;
+
+  /// Runs a command table: one command byte and one data burst per entry.
+  auto device_run_(CommandTable table) -> void;
+
+  auto device_write_ram_(const uint8_t *data, size_t length) -> void;
+
+  auto device_read_busy_() -> void;
+
+  /// Hardware reset, then waits for BUSY and the panel's settle time.
+  auto device_reset_() -> void;
+
+  auto device_init_() -> void;
+
+  auto device_init_sequence_() -> void;
+
+  auto device_wake_() -> void;
+
+  auto device_turn_on_display_() -> void;
+
+  auto device_power_off_() -> void;
+
+  auto device_deep_sleep_() -> void;
+
+  auto device_sleep_() -> void;
+
+  auto device_idle_timeout_() -> void;
+
+  auto begin_report_(Operation operation) -> void;
+  auto end_report_() -> void;
+
+  template <typename F>
+  auto timed_(Phase phase, F &&body) -> void {
+    if (phase_observer_) {
+      phase_observer_(report_.operation, phase);
+    }
+    const auto start = std::chrono::steady_clock::now();
+    body();
+    const auto duration = std::chrono::steady_clock::now() - start;
+    report_.phases.push_back({phase, start, duration});
+    phase_stats_.record(phase, duration);
+  }
+
+  /// Uploads and refreshes unless the frame is already displayed. Caller holds device_mutex_.
+  auto device_show_(std::span<const uint8_t> image, DisplayResult &result) -> void;
+
+  /// Body of display_stream(). Caller holds device_mutex_.
+  auto device_stream_(const RowProducer &producer, DisplayResult &result) -> void;
+
+  /// Hands `frame` to the worker, superseding the one still waiting.
+  auto queue_frame_(PendingFrame frame) -> std::future<DisplayResult>;
+
+  auto start_worker_() -> void;
+
+  auto worker_loop_(std::stop_token stop) -> void;
+
+  static auto complete_(PendingFrame &frame, DisplayResult result) -> void;
+};
+
+extern template class EPDDriver<Panel7in3e>;
+extern template class EPDDriver<Panel7in3f>;
+extern template class EPDDriver<Panel7in3g>;
+
+using EPD7IN3E = EPDDriver<Panel7in3e>;
+using EPD7IN3F = EPDDriver<Panel7in3f>;
+using EPD7IN3G = EPDDriver<Panel7in3g>;
+
+};  // namespace Epaper
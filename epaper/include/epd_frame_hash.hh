@@ -0,0 +1,78 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+namespace Epaper {
+
+/// XXH64 of a packed frame. Used to recognise a frame that is already on the glass; it is not a
+/// cryptographic digest.
+[[nodiscard]] inline auto frame_hash(std::span<const uint8_t> data, uint64_t seed = 0) -> uint64_t {
+  constexpr uint64_t P1 = 0x9E3779B185EBCA87ULL;
+  constexpr uint64_t P2 = 0xC2B2AE3D27D4EB4FULL;
+  constexpr uint64_t P3 = 0x165667B19E3779F9ULL;
+  constexpr uint64_t P4 = 0x85EBCA77C2B2AE63ULL;
+  constexpr uint64_t P5 = 0x27D4EB2F165667C5ULL;
+
+  auto read64 = [](const uint8_t *p) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return std::endian::native == std::endian::little ? v : std::byteswap(v);
+  };
+  auto read32 = [](const uint8_t *p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return std::endian::native == std::endian::little ? v : std::byteswap(v);
+  };
+  auto round = [](uint64_t acc, uint64_t input) {
+    return std::rotl(acc + input * P2, 31) * P1;
+  };
+  auto merge = [&](uint64_t acc, uint64_t value) { return (acc ^ round(0, value)) * P1 + P4; };
+
+  const uint8_t *p = data.data();
+  const uint8_t *const end = p + data.size();
+  uint64_t h;
+
+  if (data.size() >= 32) {
+    uint64_t v1 = seed + P1 + P2;
+    uint64_t v2 = seed + P2;
+    uint64_t v3 = seed;
+    uint64_t v4 = seed - P1;
+    for (; p + 32 <= end; p += 32) {
+      v1 = round(v1, read64(p));
+      v2 = round(v2, read64(p + 8));
+      v3 = round(v3, read64(p + 16));
+      v4 = round(v4, read64(p + 24));
+    }
+    h = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+    h = merge(h, v1);
+    h = merge(h, v2);
+    h = merge(h, v3);
+    h = merge(h, v4);
+  } else {
+    h = seed + P5;
+  }
+  h += data.size();
+
+  for (; p + 8 <= end; p += 8) {
+    h = std::rotl(h ^ round(0, read64(p)), 27) * P1 + P4;
+  }
+  if (p + 4 <= end) {
+    h = std::rotl(h ^ (read32(p) * P1), 23) * P2 + P3;
+    p += 4;
+  }
+  for (; p < end; ++p) {
+    h = std::rotl(h ^ (*p * P5), 11) * P1;
+  }
+
+  h ^= h >> 33;
+  h *= P2;
+  h ^= h >> 29;
+  h *= P3;
+  h ^= h >> 32;
+  return h;
+}
+
+};  // namespace Epaper
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "epd_driver.hh"
+
+namespace Epaper {
+
+/// Several panels of one type updated together, e.g. a wall on separate chip selects. Each driver's
+/// worker uploads and refreshes its own panel: uploads share the bus (the transports serialise the
+/// bursts) while the BUSY periods overlap, so N panels take about one refresh plus N uploads.
+template <typename Panel>
+class PanelGroup {
+ private:
+  std::vector<std::unique_ptr<EPDDriver<Panel>>> panels_;
+
+ public:
+  /// Brings every panel up concurrently; each reset and init sequence waits on its own BUSY line.
+  explicit PanelGroup(std::span<const PinConfig> pins) {
+    std::vector<std::future<std::unique_ptr<EPDDriver<Panel>>>> pending;
+    pending.reserve(pins.size());
+    for (const auto &config : pins) {
+      pending.push_back(std::async(std::launch::async, [config] {
+        return std::make_unique<EPDDriver<Panel>>(config);
+      }));
+    }
+    panels_.reserve(pins.size());
+    for (auto &panel : pending) {
+      panels_.push_back(panel.get());
+    }
+  }
+
+  explicit PanelGroup(std::vector<std::unique_ptr<EPDDriver<Panel>>> panels)
+      : panels_(std::move(panels)) {}
+
+  [[nodiscard]] auto size() const -> size_t { return panels_.size(); }
+  [[nodiscard]] auto operator[](size_t index) -> EPDDriver<Panel> & { return *panels_[index]; }
+
+  /// Queues frames[i] for panel i and returns at once; see EPDDriver::display_async().
+  auto display_async(std::span<const std::span<const uint8_t>> frames)
+      -> std::vector<std::future<DisplayResult>> {
+    if (frames.size() != panels_.size()) {
+      throw std::invalid_argument("Expected one frame per panel");
+    }
+    std::vector<std::future<DisplayResult>> results;
+    results.reserve(frames.size());
+    for (size_t i = 0; i < frames.size(); ++i) {
+      results.push_back(panels_[i]->display_async(frames[i]));
+    }
+    return results;
+  }
+
+  /// Shows frames[i] on panel i and blocks until every panel has finished.
+  auto display(std::span<const std::span<const uint8_t>> frames) -> std::vector<DisplayResult> {
+    auto pending = display_async(frames);
+    std::vector<DisplayResult> results;
+    results.reserve(pending.size());
+    for (auto &result : pending) {
+      results.push_back(result.get());
+    }
+    return results;
+  }
+};
+
+};  // namespace Epaper
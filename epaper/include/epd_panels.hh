@@ -0,0 +1,220 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <span>
+
+#include "epd_command_table.hh"
+
+namespace Epaper {
+
+using namespace std::chrono_literals;
+
+/// Frame layout shared by every panel: rows of packed colour indices, leftmost pixel in the most
+/// significant bits of each byte.
+template <int W, int H, int BPP>
+struct PanelGeometry {
+  static_assert(BPP == 1 || BPP == 2 || BPP == 4 || BPP == 8);
+
+  static constexpr int WIDTH = W;
+  static constexpr int HEIGHT = H;
+  static constexpr int BITS_PER_PIXEL = BPP;
+  static constexpr int PIXELS_PER_BYTE = 8 / BPP;
+  static constexpr size_t ROW_BYTES = static_cast<size_t>(W / PIXELS_PER_BYTE);
+  static constexpr size_t FRAME_BYTES = ROW_BYTES * H;
+
+  static_assert(W % PIXELS_PER_BYTE == 0, "rows must end on a byte boundary");
+};
+
+enum class EPDColor : uint8_t {
+  BLACK = 0x00,  /*!< Black */
+  WHITE = 0x01,  /*!< White */
+  YELLOW = 0x02, /*!< Yellow */
+  RED = 0x03,    /*!< Red */
+  BLUE = 0x05,   /*!< Blue */
+  GREEN = 0x06,  /*!< Green */
+};
+
+/// 7.3" Spectra 6 (E), 800x480, 6 colours at 4 bpp.
+struct Panel7in3e : PanelGeometry<800, 480, 4> {
+  using Color = EPDColor;
+  static constexpr Color CLEAR_COLOR = Color::WHITE;
+  static constexpr std::chrono::milliseconds RESET_SETTLE{0};
+  /// RGB of each colour index, for rendering frames off the panel. Index 4 is unused.
+  static constexpr std::array<std::array<uint8_t, 3>, 7> PALETTE = {{
+      {0x00, 0x00, 0x00},
+      {0xFF, 0xFF, 0xFF},
+      {0xFF, 0xFF, 0x00},
+      {0xFF, 0x00, 0x00},
+      {0xFF, 0x00, 0xFF},
+      {0x00, 0x00, 0xFF},
+      {0x00, 0xFF, 0x00},
+  }};
+
+  static constexpr uint8_t CMD_WRITE_RAM = 0x10;
+
+  static constexpr std::array INIT = {
+      command(0xAA, {0x49, 0x55, 0x20, 0x08, 0x09, 0x18}),  // CMDH
+      command(0x01, {0x3F}),                                // Power setting
+      command(0x00, {0x5F, 0x69}),                          // Panel setting
+      command(0x03, {0x00, 0x54, 0x00, 0x44}),              // Power off sequence
+      command(0x05, {0x40, 0x1F, 0x1F, 0x2C}),              // Booster soft start 1
+      command(0x06, {0x6F, 0x1F, 0x17, 0x49}),              // Booster soft start 2
+      command(0x08, {0x6F, 0x1F, 0x1F, 0x22}),              // Booster soft start 3
+      command(0x30, {0x03}),                                // PLL
+      command(0x50, {0x3F}),                                // VCOM and data interval
+      command(0x60, {0x02, 0x00}),                          // TCON
+      command(0x61, {0x03, 0x20, 0x01, 0xE0}),              // Resolution 800x480
+      command(0x84, {0x01}),
+      command(0xE3, {0x2F}),  // Power saving
+  };
+  static constexpr std::array POWER_ON = {command_wait(0x04)};
+  static constexpr std::array REFRESH = {
+      command(0x06, {0x6F, 0x1F, 0x17, 0x49}),  // Second setting
+      command_wait(0x12, {0x00}),               // DISPLAY_REFRESH
+  };
+  static constexpr std::array POWER_OFF = {command_wait(0x02, {0x00})};
+  static constexpr std::array DEEP_SLEEP = {command(0x07, {0xA5})};
+};
+
+/// 7.3" ACeP (F), 800x480, 7 colours at 4 bpp.
+struct Panel7in3f : PanelGeometry<800, 480, 4> {
+  enum class Color : uint8_t {
+    BLACK = 0x00,
+    WHITE = 0x01,
+    GREEN = 0x02,
+    BLUE = 0x03,
+    RED = 0x04,
+    YELLOW = 0x05,
+    ORANGE = 0x06,
+    CLEAN = 0x07, /*!< Used by the vendor to clear ghosting */
+  };
+  static constexpr Color CLEAR_COLOR = Color::WHITE;
+  static constexpr std::chrono::milliseconds RESET_SETTLE{30};
+  static constexpr std::array<std::array<uint8_t, 3>, 8> PALETTE = {{
+      {0x00, 0x00, 0x00},
+      {0xFF, 0xFF, 0xFF},
+      {0x00, 0xFF, 0x00},
+      {0x00, 0x00, 0xFF},
+      {0xFF, 0x00, 0x00},
+      {0xFF, 0xFF, 0x00},
+      {0xFF, 0x80, 0x00},
+      {0xFF, 0xFF, 0xFF},
+  }};
+
+  static constexpr uint8_t CMD_WRITE_RAM = 0x10;
+
+  static constexpr std::array INIT = {
+      command(0xAA, {0x49, 0x55, 0x20, 0x08, 0x09, 0x18}),  // CMDH
+      command(0x01, {0x3F, 0x00, 0x32, 0x2A, 0x0E, 0x2A}),  // Power setting
+      command(0x00, {0x5F, 0x69}),                          // Panel setting
+      command(0x03, {0x00, 0x54, 0x00, 0x44}),              // Power off sequence
+      command(0x05, {0x40, 0x1F, 0x1F, 0x2C}),              // Booster soft start 1
+      command(0x06, {0x6F, 0x1F, 0x16, 0x25}),              // Booster soft start 2
+      command(0x08, {0x6F, 0x1F, 0x1F, 0x22}),              // Booster soft start 3
+      command(0x13, {0x00, 0x04}),                          // IPC
+      command(0x30, {0x02}),                                // PLL
+      command(0x41, {0x00}),                                // TSE
+      command(0x50, {0x3F}),                                // VCOM and data interval
+      command(0x60, {0x02, 0x00}),                          // TCON
+      command(0x61, {0x03, 0x20, 0x01, 0xE0}),              // Resolution 800x480
+      command(0x82, {0x1E}),                                // VDCS
+      command(0x84, {0x00}),
+      command(0x86, {0x00}),  // AGID
+      command(0xE3, {0x2F}),  // Power saving
+      command(0xE0, {0x00}),  // CCSET
+      command(0xE6, {0x00}),  // TSSET
+  };
+  static constexpr std::array POWER_ON = {command_wait(0x04)};
+  static constexpr std::array REFRESH = {command_wait(0x12, {0x00})};
+  static constexpr std::array POWER_OFF = {command_wait(0x02, {0x00})};
+  static constexpr std::array DEEP_SLEEP = {command(0x07, {0xA5})};
+};
+
+/// 7.3" (G), 800x480, 4 colours at 2 bpp.
+struct Panel7in3g : PanelGeometry<800, 480, 2> {
+  enum class Color : uint8_t {
+    BLACK = 0x0,
+    WHITE = 0x1,
+    YELLOW = 0x2,
+    RED = 0x3,
+  };
+  static constexpr Color CLEAR_COLOR = Color::WHITE;
+  static constexpr std::chrono::milliseconds RESET_SETTLE{0};
+  static constexpr std::array<std::array<uint8_t, 3>, 4> PALETTE = {{
+      {0x00, 0x00, 0x00},
+      {0xFF, 0xFF, 0xFF},
+      {0xFF, 0xFF, 0x00},
+      {0xFF, 0x00, 0x00},
+  }};
+
+  static constexpr uint8_t CMD_WRITE_RAM = 0x10;
+
+  static constexpr std::array INIT = {
+      command(0xAA, {0x49, 0x55, 0x20, 0x08, 0x09, 0x18}),  // CMDH
+      command(0x01, {0x3F}),                                // Power setting
+      command(0x00, {0x4F, 0x69}),                          // Panel setting
+      command(0x05, {0x40, 0x1F, 0x1F, 0x2C}),              // Booster soft start 1
+      command(0x06, {0x6F, 0x1F, 0x1F, 0x22}),              // Booster soft start 2
+      command(0x08, {0x6F, 0x1F, 0x1F, 0x22}),              // Booster soft start 3
+      command(0x13, {0x00, 0x04}),                          // IPC
+      command(0x30, {0x02}),                                // PLL
+      command(0x41, {0x00}),                                // TSE
+      command(0x50, {0x3F}),                                // VCOM and data interval
+      command(0x60, {0x02, 0x00}),                          // TCON
+      command(0x61, {0x03, 0x20, 0x01, 0xE0}),              // Resolution 800x480
+      command(0x82, {0x1E}),                                // VDCS
+      command(0x84, {0x01}),
+      command(0x86, {0x00}),  // AGID
+      command(0xE3, {0x2F}),  // Power saving
+      command(0xE0, {0x00}),  // CCSET
+      command(0xE6, {0x00}),  // TSSET
+  };
+  static constexpr std::array POWER_ON = {command_wait(0x04)};
+  static constexpr std::array REFRESH = {command_wait(0x12, {0x01})};
+  static constexpr std::array POWER_OFF = {command_wait(0x02, {0x00})};
+  static constexpr std::array DEEP_SLEEP = {command(0x07, {0xA5})};
+};
+
+/// `color` repeated across every pixel of a byte, e.g. 0x11 for white at 4 bpp.
+template <typename Panel>
+[[nodiscard]] constexpr auto fill_byte(typename Panel::Color color) -> uint8_t {
+  uint8_t byte = 0;
+  for (int i = 0; i < Panel::PIXELS_PER_BYTE; ++i) {
+    byte = static_cast<uint8_t>((byte << Panel::BITS_PER_PIXEL) | static_cast<uint8_t>(color));
+  }
+  return byte;
+}
+
+/// Packs one colour index per element of `pixels` into `out`, which must hold
+/// pixels.size() / PIXELS_PER_BYTE bytes.
+template <typename Panel>
+constexpr auto pack_pixels(std::span<const uint8_t> pixels, std::span<uint8_t> out) -> void {
+  constexpr int N = Panel::PIXELS_PER_BYTE;
+  constexpr auto MASK = static_cast<uint8_t>((1U << Panel::BITS_PER_PIXEL) - 1);
+  for (size_t i = 0; i < out.size(); ++i) {
+    uint8_t byte = 0;
+    for (int j = 0; j < N; ++j) {
+      byte = static_cast<uint8_t>((byte << Panel::BITS_PER_PIXEL) | (pixels[i * N + j] & MASK));
+    }
+    out[i] = byte;
+  }
+}
+
+/// Writes one pixel of a packed frame; coordinates outside the panel are ignored.
+template <typename Panel>
+constexpr auto set_pixel(std::span<uint8_t> frame, int x, int y, typename Panel::Color color)
+    -> void {
+  if (x < 0 || x >= Panel::WIDTH || y < 0 || y >= Panel::HEIGHT) {
+    return;
+  }
+  constexpr int N = Panel::PIXELS_PER_BYTE;
+  constexpr auto MASK = static_cast<uint8_t>((1U << Panel::BITS_PER_PIXEL) - 1);
+  const int shift = (N - 1 - x % N) * Panel::BITS_PER_PIXEL;
+  auto &byte = frame[static_cast<size_t>(y) * Panel::ROW_BYTES + static_cast<size_t>(x / N)];
+  byte = static_cast<uint8_t>((byte & ~(MASK << shift)) |
+                              ((static_cast<uint8_t>(color) & MASK) << shift));
+}
+
+};  // namespace Epaper
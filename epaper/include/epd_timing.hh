@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace Epaper {
+
+/// Steps of a driver call that are timed separately. Busy waits are included in the phase that
+/// triggers them.
+enum class Phase : uint8_t {
+  RESET,         /*!< RST pulse and the first BUSY wait */
+  INIT_SEQUENCE, /*!< Panel configuration commands */
+  RAM_UPLOAD,    /*!< Frame write to panel RAM */
+  POWER_ON,      /*!< POWER_ON and its BUSY wait */
+  REFRESH,       /*!< DISPLAY_REFRESH and its BUSY wait */
+  POWER_OFF,     /*!< POWER_OFF and its BUSY wait */
+  DEEP_SLEEP,    /*!< DEEP_SLEEP command */
+};
+inline constexpr size_t PHASE_COUNT = 7;
+
+enum class Operation : uint8_t { INIT, DISPLAY, CLEAR, SLEEP, IDLE };
+inline constexpr size_t OPERATION_COUNT = 5;
+
+[[nodiscard]] auto to_string(Phase phase) -> std::string_view;
+[[nodiscard]] auto to_string(Operation operation) -> std::string_view;
+
+struct PhaseTiming {
+  Phase phase;
+  std::chrono::steady_clock::time_point start;
+  std::chrono::nanoseconds duration;
+};
+
+/// Timeline of one driver call.
+struct CallReport {
+  Operation operation = Operation::DISPLAY;
+  std::chrono::steady_clock::time_point start{};
+  std::chrono::nanoseconds total{};
+  std::vector<PhaseTiming> phases;
+
+  /// Sum of all entries for `phase`; zero when the phase did not run.
+  [[nodiscard]] auto duration(Phase phase) const -> std::chrono::nanoseconds;
+};
+
+struct PhaseStats {
+  uint64_t count = 0;
+  std::chrono::nanoseconds min{};
+  std::chrono::nanoseconds avg{};
+  std::chrono::nanoseconds max{};
+  std::chrono::nanoseconds p99{};  // over the most recent WINDOW samples
+};
+
+/// Running per-phase counters. min/avg/max cover every sample since construction; p99 is taken
+/// over a sliding window so it follows regressions.
+class PhaseRecorder {
+ public:
+  static constexpr size_t WINDOW = 256;
+
+  auto record(Phase phase, std::chrono::nanoseconds duration) -> void;
+  [[nodiscard]] auto stats(Phase phase) const -> PhaseStats;
+  [[nodiscard]] auto snapshot() const -> std::array<PhaseStats, PHASE_COUNT>;
+
+ private:
+  struct Counter {
+    uint64_t count = 0;
+    std::chrono::nanoseconds min = std::chrono::nanoseconds::max();
+    std::chrono::nanoseconds max{};
+    std::chrono::nanoseconds sum{};
+    std::array<std::chrono::nanoseconds, WINDOW> window{};
+  };
+
+  [[nodiscard]] static auto summarize_(const Counter &counter) -> PhaseStats;
+
+  mutable std::mutex mutex_;
+  std::array<Counter, PHASE_COUNT> counters_{};
+};
+
+};  // namespace Epaper
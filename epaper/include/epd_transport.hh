@@ -0,0 +1,69 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+
+namespace Epaper {
+
+/// Wiring of one panel. The defaults match a single Waveshare HAT on CE0; further panels on the
+/// same Pi need their own RST/DC/BUSY lines and the other chip select, and may share `pwr`.
+struct PinConfig {
+  ::std::filesystem::path gpio_chip = "/dev/gpiochip0";
+  unsigned int rst = 17;
+  unsigned int dc = 25;
+  unsigned int busy = 24;
+  /// Panel power switch; empty for boards that power the panel permanently. Panels naming the same
+  /// line share it: it turns on with the first of them and off with the last.
+  std::optional<unsigned int> pwr = 18;
+  /// SPI0 chip select: 0 for CE0, 1 for CE1.
+  unsigned int chip_select = 0;
+};
+
+/// Frame format of the panel behind a transport. Hardware backends ignore it; the simulator sizes
+/// its RAM from it and renders refreshed frames through `palette`.
+struct PanelFormat {
+  int width = 800;
+  int height = 480;
+  int bits_per_pixel = 4;
+  /// RGB of each colour index; indices past the end render magenta.
+  std::span<const std::array<uint8_t, 3>> palette;
+};
+
+/// Format of a panel described by its traits in epd_panels.hh.
+template <typename Panel>
+[[nodiscard]] constexpr auto panel_format() -> PanelFormat {
+  return {Panel::WIDTH, Panel::HEIGHT, Panel::BITS_PER_PIXEL, Panel::PALETTE};
+}
+
+/// Bus-level operations the panel driver needs: command/data bytes on SPI with the DC line, the
+/// reset pulse and the BUSY handshake. Backends decide how those reach the hardware.
+class Transport {
+ public:
+  virtual ~Transport() = default;
+
+  virtual auto reset() -> void = 0;
+  virtual auto send_command(uint8_t command) -> void = 0;
+  virtual auto send_data(std::span<const uint8_t> data) -> void = 0;
+  /// Blocks until the controller releases BUSY; throws std::runtime_error after `timeout`.
+  virtual auto wait_busy(std::chrono::milliseconds timeout) -> void = 0;
+
+  /// Non-blocking BUSY query. Also consumes the notification pending on busy_fd().
+  virtual auto is_busy() -> bool = 0;
+
+  /// Descriptor that becomes readable when BUSY may have been released, for use with poll/epoll.
+  /// -1 when the backend has none.
+  [[nodiscard]] virtual auto busy_fd() const -> int { return -1; }
+};
+
+/// Backend selected by the EPAPER_TRANSPORT environment variable ("bcm2835", "spidev" or "sim").
+/// Without it, the first hardware backend compiled into the library is used, falling back to the
+/// simulator on hosts without libgpiod, which emulates a panel of format `panel`.
+auto make_transport(const PinConfig &pins = {}, const PanelFormat &panel = {})
+    -> std::unique_ptr<Transport>;
+
+};  // namespace Epaper
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <linux/spi/spidev.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <gpiod.hpp>
+#include <span>
+#include <vector>
+
+#include "epd_transport.hh"
+
+namespace Epaper {
+
+/// RST/DC/BUSY lines of one panel, requested through libgpiod, plus its share of the PWR line.
+class GpioLines {
+ private:
+  const PinConfig pins_;
+  ::gpiod::line_request request;
+  ::gpiod::edge_event_buffer events_{4};
+
+  bool data_mode_ = false;
+
+ public:
+  explicit GpioLines(const PinConfig &pins);
+  ~GpioLines();
+
+  GpioLines(const GpioLines &) = delete;
+  auto operator=(const GpioLines &) -> GpioLines & = delete;
+
+  auto reset() -> void;
+  auto wait_busy(std::chrono::milliseconds timeout) -> void;
+  auto is_busy() -> bool;
+
+  /// The line request's descriptor; BUSY is requested with rising-edge detection, so it becomes
+  /// readable when the controller goes idle.
+  [[nodiscard]] auto busy_fd() const -> int { return request.fd(); }
+
+  /// Drives DC high for data and low for commands; skips the ioctl when already there.
+  auto set_data_mode(bool data) -> void;
+};
+
+/// Original backend: SPI through the bcm2835 library (/dev/mem, root only). The library drives a
+/// single global SPI block, so every instance shares one bus lock and one init/close refcount.
+class Bcm2835Transport final : public Transport {
+ private:
+  GpioLines lines_;
+  const uint8_t chip_select_;
+
+ public:
+  explicit Bcm2835Transport(const PinConfig &pins = {});
+  ~Bcm2835Transport() override;
+
+  auto reset() -> void override { lines_.reset(); }
+  auto send_command(uint8_t command) -> void override;
+  auto send_data(std::span<const uint8_t> data) -> void override;
+  auto wait_busy(std::chrono::milliseconds timeout) -> void override { lines_.wait_busy(timeout); }
+  auto is_busy() -> bool override { return lines_.is_busy(); }
+  [[nodiscard]] auto busy_fd() const -> int override { return lines_.busy_fd(); }
+};
+
+/// Kernel spidev backend. Large bursts are split into segments and several segments go out per
+/// SPI_IOC_MESSAGE ioctl, bounded by the spidev module's bufsiz.
+class SpidevTransport final : public Transport {
+ private:
+  static constexpr uint32_t SPEED_HZ = 10000000;
+  static constexpr size_t MAX_SEGMENT_SIZE = 4096;
+  static constexpr size_t MAX_SEGMENTS_PER_MESSAGE = 511;  // ioctl size field is 14 bits
+
+  GpioLines lines_;
+  int fd_ = -1;
+  size_t segment_size_ = MAX_SEGMENT_SIZE;
+  size_t segments_per_message_ = 1;
+  std::vector<spi_ioc_transfer> transfers_;
+
+ public:
+  /// Opens /dev/spidev0.<chip_select>.
+  explicit SpidevTransport(const PinConfig &pins = {});
+  ~SpidevTransport() override;
+
+  auto reset() -> void override { lines_.reset(); }
+  auto send_command(uint8_t command) -> void override;
+  auto send_data(std::span<const uint8_t> data) -> void override;
+  auto wait_busy(std::chrono::milliseconds timeout) -> void override { lines_.wait_busy(timeout); }
+  auto is_busy() -> bool override { return lines_.is_busy(); }
+  [[nodiscard]] auto busy_fd() const -> int override { return lines_.busy_fd(); }
+
+ private:
+  auto write_(std::span<const uint8_t> data) -> void;
+};
+
+};  // namespace Epaper
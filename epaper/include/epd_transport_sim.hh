@@ -0,0 +1,95 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include "epd_panels.hh"
+#include "epd_transport.hh"
+
+namespace Epaper {
+
+/// How long the simulated controller holds BUSY low after each operation.
+struct SimulatedTimings {
+  std::chrono::milliseconds reset{20};
+  std::chrono::milliseconds power_on{90};
+  std::chrono::milliseconds refresh{19000};
+  std::chrono::milliseconds power_off{40};
+
+  /// Multiplies every duration, e.g. 0 for instant CI runs.
+  [[nodiscard]] auto scaled(double factor) const -> SimulatedTimings;
+};
+
+/// In-memory stand-in for the panel controller. It decodes the command stream into RAM and
+/// displayed framebuffers, emulates the BUSY line and optionally dumps each refreshed frame to PNG.
+class SimulatedTransport final : public Transport {
+ private:
+  static constexpr uint8_t CMD_PANEL_SETTING = 0x00;
+  static constexpr uint8_t CMD_POWER_OFF = 0x02;
+  static constexpr uint8_t CMD_POWER_ON = 0x04;
+  static constexpr uint8_t CMD_DEEP_SLEEP = 0x07;
+  static constexpr uint8_t CMD_WRITE_RAM = 0x10;
+  static constexpr uint8_t CMD_DISPLAY_REFRESH = 0x12;
+  static constexpr uint8_t DEEP_SLEEP_CHECK = 0xA5;
+
+  const PanelFormat panel_;
+  const SimulatedTimings timings_;
+  const ::std::filesystem::path png_path_;
+
+  const int timer_fd_;
+
+  mutable std::mutex mutex_;
+  std::chrono::steady_clock::time_point busy_until_{};
+  uint8_t command_ = CMD_PANEL_SETTING;
+  size_t ram_offset_ = 0;
+  bool powered_ = false;
+  bool sleeping_ = false;
+  std::vector<uint8_t> ram_;
+  std::vector<uint8_t> displayed_;
+  std::map<uint8_t, std::vector<uint8_t>> registers_;
+  size_t refresh_count_ = 0;
+  size_t protocol_errors_ = 0;
+
+ public:
+  explicit SimulatedTransport(SimulatedTimings timings = {}, ::std::filesystem::path png_path = {},
+                              PanelFormat panel = panel_format<Panel7in3e>());
+  ~SimulatedTransport() override;
+
+  SimulatedTransport(const SimulatedTransport &) = delete;
+  auto operator=(const SimulatedTransport &) -> SimulatedTransport & = delete;
+
+  auto reset() -> void override;
+  auto send_command(uint8_t command) -> void override;
+  auto send_data(std::span<const uint8_t> data) -> void override;
+  auto wait_busy(std::chrono::milliseconds timeout) -> void override;
+  auto is_busy() -> bool override;
+
+  /// timerfd armed for the end of the current busy period.
+  [[nodiscard]] auto busy_fd() const -> int override { return timer_fd_; }
+
+  /// Packed frame currently shown on the simulated glass.
+  [[nodiscard]] auto displayed_frame() const -> std::vector<uint8_t>;
+  /// Last payload written to a configuration register such as 0x61 (resolution).
+  [[nodiscard]] auto register_value(uint8_t command) const -> std::vector<uint8_t>;
+  [[nodiscard]] auto refresh_count() const -> size_t;
+  /// Commands that a real controller would drop: sent while busy, asleep or unpowered.
+  [[nodiscard]] auto protocol_errors() const -> size_t;
+
+  auto write_png(const ::std::filesystem::path &path) const -> void;
+
+ private:
+  [[nodiscard]] auto busy_() const -> bool;
+  auto start_busy_(std::chrono::milliseconds duration) -> void;
+  auto protocol_error_(const char *what) -> void;
+  auto write_png_(const ::std::filesystem::path &path) const -> void;
+};
+
+/// Simulator of a `panel` configured from EPAPER_SIM_TIME_SCALE and EPAPER_SIM_PNG.
+auto make_simulated_transport(const PanelFormat &panel = panel_format<Panel7in3e>())
+    -> std::unique_ptr<SimulatedTransport>;
+
+};  // namespace Epaper
@@ -0,0 +1,560 @@
+#include "epd_driver.hh"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <print>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "epd_frame_hash.hh"
+
+namespace Epaper {
+
+template <typename Panel>
+EPDDriver<Panel>::EPDDriver() : EPDDriver(make_transport({}, panel_format<Panel>())) {}
+
+template <typename Panel>
+EPDDriver<Panel>::EPDDriver(const PinConfig &pins)
+    : EPDDriver(make_transport(pins, panel_format<Panel>())) {}
+
+template <typename Panel>
+EPDDriver<Panel>::EPDDriver(std::unique_ptr<Transport> transport)
+    : transport_(std::move(transport)) {
+  device_init_();
+}
+
+template <typename Panel>
+EPDDriver<Panel>::~EPDDriver() {
+  if (worker_.joinable()) {
+    worker_.request_stop();
+    worker_.join();
+  }
+  cancel_pending();
+
+  // No idle timer may outlive the worker, so the shutdown refresh powers off right away.
+  set_power_policy({});
+  // A BUSY timeout or transport error here must not escape the destructor.
+  try {
+    if (shutdown_policy_ == ShutdownPolicy::CLEAR) {
+      clear(Panel::CLEAR_COLOR);
+    }
+    std::lock_guard device_lock(device_mutex_);
+    device_sleep_();
+  } catch (const std::exception &e) {
+    std::println(stderr, "e-Paper shutdown failed: {}", e.what());
+  }
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::clear(Color color) -> void {
+  const std::vector<uint8_t> frame(FRAME_BYTES, fill_byte<Panel>(color));
+
+  std::lock_guard device_lock(device_mutex_);
+  begin_report_(Operation::CLEAR);
+  if (power_state_ == PowerState::SLEEP) {
+    device_wake_();
+  }
+  displayed_hash_.reset();
+  device_write_ram_(frame.data(), frame.size());
+  device_turn_on_display_();
+  displayed_hash_ = frame_hash(frame);
+  end_report_();
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::display(std::span<const uint8_t> image) -> DisplayResult {
+  if (image.size() != FRAME_BYTES) {
+    throw std::invalid_argument("Frame size does not match the e-Paper buffer");
+  }
+  DisplayResult result;
+  std::lock_guard device_lock(device_mutex_);
+  device_show_(image, result);
+  return result;
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::display_stream(const RowProducer &producer) -> DisplayResult {
+  DisplayResult result;
+  std::lock_guard device_lock(device_mutex_);
+  device_stream_(producer, result);
+  return result;
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::device_stream_(const RowProducer &producer, DisplayResult &result) -> void {
+  std::vector<uint8_t> frame(FRAME_BYTES);
+  begin_report_(Operation::DISPLAY);
+  if (power_state_ == PowerState::SLEEP) {
+    device_wake_();
+  }
+
+  // Rows [0, produced) are final; the uploader sends them in blocks and stops early on abort.
+  std::mutex progress_mutex;
+  std::condition_variable progress_cv;
+  int produced = 0;
+  bool aborted = false;
+  std::exception_ptr upload_error;
+
+  timed_(Phase::RAM_UPLOAD, [&] {
+    device_send_command_(Panel::CMD_WRITE_RAM);
+    std::jthread uploader([&] {
+      int uploaded = 0;
+      try {
+        while (uploaded < HEIGHT) {
+          int ready = 0;
+          {
+            std::unique_lock lock(progress_mutex);
+            progress_cv.wait(lock, [&] {
+              return aborted || produced == HEIGHT || produced - uploaded >= STREAM_BLOCK_ROWS;
+            });
+            if (aborted) {
+              return;
+            }
+            ready = produced;
+          }
+          device_send_data_(frame.data() + static_cast<size_t>(uploaded) * Panel::ROW_BYTES,
+                            static_cast<size_t>(ready - uploaded) * Panel::ROW_BYTES);
+          uploaded = ready;
+        }
+      } catch (...) {
+        std::lock_guard lock(progress_mutex);
+        upload_error = std::current_exception();
+        aborted = true;
+      }
+    });
+
+    auto stop = [&] {
+      {
+        std::lock_guard lock(progress_mutex);
+        aborted = true;
+      }
+      progress_cv.notify_one();
+    };
+    for (int row = 0; row < HEIGHT; ++row) {
+      const auto packed_row = std::span(frame).subspan(
+          static_cast<size_t>(row) * Panel::ROW_BYTES, Panel::ROW_BYTES);
+      bool keep_going = false;
+      try {
+        keep_going = producer(row, packed_row);
+      } catch (...) {
+        stop();
+        throw;
+      }
+      if (!keep_going) {
+        stop();
+        return;
+      }
+
+      std::lock_guard lock(progress_mutex);
+      if (aborted) {
+        return;
+      }
+      produced = row + 1;
+      if (produced % STREAM_BLOCK_ROWS == 0 || produced == HEIGHT) {
+        progress_cv.notify_one();
+      }
+    }
+  });
+
+  if (upload_error) {
+    std::rethrow_exception(upload_error);
+  }
+  // The upload already ran, so a cancelled or skipped frame still reports it.
+  if (aborted) {
+    // RAM holds a partial frame but the glass still shows the previous one.
+    result.outcome = DisplayOutcome::CANCELLED;
+  } else if (const auto hash = frame_hash(frame); skip_identical_ && displayed_hash_ == hash) {
+    result.outcome = DisplayOutcome::SKIPPED;
+  } else {
+    displayed_hash_.reset();
+    device_turn_on_display_();
+    displayed_hash_ = hash;
+  }
+  end_report_();
+  result.report = report_;
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::display_async(std::span<const uint8_t> image, DisplayCallback on_complete)
+    -> std::future<DisplayResult> {
+  auto copy = std::make_shared<const std::vector<uint8_t>>(image.begin(), image.end());
+  return display_async(*copy, copy, std::move(on_complete));
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::display_async(std::span<const uint8_t> image,
+                                     std::shared_ptr<const void> owner, DisplayCallback on_complete)
+    -> std::future<DisplayResult> {
+  if (image.size() != FRAME_BYTES) {
+    throw std::invalid_argument("Frame size does not match the e-Paper buffer");
+  }
+
+  return queue_frame_({
+      .image = image,
+      .owner = std::move(owner),
+      .producer = {},
+      .promise = {},
+      .on_complete = std::move(on_complete),
+      .submitted = std::chrono::steady_clock::now(),
+  });
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::display_stream_async(RowProducer producer, DisplayCallback on_complete)
+    -> std::future<DisplayResult> {
+  return queue_frame_({
+      .image = {},
+      .owner = {},
+      .producer = std::move(producer),
+      .promise = {},
+      .on_complete = std::move(on_complete),
+      .submitted = std::chrono::steady_clock::now(),
+  });
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::queue_frame_(PendingFrame frame) -> std::future<DisplayResult> {
+  auto future = frame.promise.get_future();
+
+  std::optional<PendingFrame> superseded;
+  {
+    std::lock_guard lock(pending_mutex_);
+    superseded = std::exchange(pending_, std::move(frame));
+    if (!worker_.joinable()) {
+      start_worker_();
+    }
+  }
+  pending_cv_.notify_one();
+
+  if (superseded) {
+    complete_(*superseded, {.outcome = DisplayOutcome::SUPERSEDED});
+  }
+  return future;
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::cancel_pending() -> bool {
+  std::optional<PendingFrame> cancelled;
+  {
+    std::lock_guard lock(pending_mutex_);
+    cancelled = std::exchange(pending_, std::nullopt);
+  }
+  if (!cancelled) {
+    return false;
+  }
+  complete_(*cancelled, {.outcome = DisplayOutcome::CANCELLED});
+  return true;
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::set_shutdown_policy(ShutdownPolicy policy) -> void {
+  std::lock_guard device_lock(device_mutex_);
+  shutdown_policy_ = policy;
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::set_power_policy(PowerPolicy policy) -> void {
+  std::lock_guard device_lock(device_mutex_);
+  power_policy_ = policy;
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::power_state() -> PowerState {
+  std::lock_guard device_lock(device_mutex_);
+  return power_state_;
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::set_skip_identical(bool enabled) -> void {
+  std::lock_guard device_lock(device_mutex_);
+  skip_identical_ = enabled;
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::invalidate_displayed() -> void {
+  std::lock_guard device_lock(device_mutex_);
+  displayed_hash_.reset();
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::displayed_hash() -> std::optional<uint64_t> {
+  std::lock_guard device_lock(device_mutex_);
+  return displayed_hash_;
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::set_displayed_hash(uint64_t hash) -> void {
+  std::lock_guard device_lock(device_mutex_);
+  displayed_hash_ = hash;
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::device_show_(std::span<const uint8_t> image, DisplayResult &result) -> void {
+  const auto hash = frame_hash(image);
+  if (skip_identical_ && displayed_hash_ == hash) {
+    result.outcome = DisplayOutcome::SKIPPED;
+    return;
+  }
+
+  begin_report_(Operation::DISPLAY);
+  if (power_state_ == PowerState::SLEEP) {
+    device_wake_();
+  }
+  // Until the refresh completes the glass holds neither the old nor the new frame reliably.
+  displayed_hash_.reset();
+  device_write_ram_(image.data(), image.size());
+  device_turn_on_display_();
+  displayed_hash_ = hash;
+  end_report_();
+  result.report = report_;
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::set_phase_observer(PhaseObserver observer) -> void {
+  std::lock_guard device_lock(device_mutex_);
+  phase_observer_ = std::move(observer);
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::last_report(Operation operation) -> CallReport {
+  std::lock_guard device_lock(device_mutex_);
+  return last_reports_[static_cast<size_t>(operation)];
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::begin_report_(Operation operation) -> void {
+  report_.operation = operation;
+  report_.start = std::chrono::steady_clock::now();
+  report_.total = {};
+  report_.phases.clear();
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::end_report_() -> void {
+  report_.total = std::chrono::steady_clock::now() - report_.start;
+  last_reports_[static_cast<size_t>(report_.operation)] = report_;
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::start_worker_() -> void {
+  worker_ = std::jthread([this](std::stop_token stop) { worker_loop_(stop); });
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::worker_loop_(std::stop_token stop) -> void {
+  while (true) {
+    std::optional<PendingFrame> frame;
+    {
+      std::unique_lock lock(pending_mutex_);
+      auto ready = [this] {
+        return pending_.has_value() ||
+               (idle_deadline_ && std::chrono::steady_clock::now() >= *idle_deadline_);
+      };
+      while (!stop.stop_requested() && !ready()) {
+        // A refresh that sets or moves the deadline wakes us to re-arm the wait for it.
+        const auto deadline = idle_deadline_;
+        auto rearm = [&] { return ready() || idle_deadline_ != deadline; };
+        if (deadline) {
+          pending_cv_.wait_until(lock, stop, *deadline, rearm);
+        } else {
+          pending_cv_.wait(lock, stop, rearm);
+        }
+      }
+      if (stop.stop_requested()) {
+        return;
+      }
+      frame = std::exchange(pending_, std::nullopt);
+    }
+
+    if (!frame) {
+      device_idle_timeout_();
+      continue;
+    }
+
+    DisplayResult result;
+    try {
+      std::lock_guard device_lock(device_mutex_);
+      result.queued = std::chrono::steady_clock::now() - frame->submitted;
+      if (frame->producer) {
+        device_stream_(frame->producer, result);
+      } else {
+        device_show_(frame->image, result);
+      }
+    } catch (...) {
+      result.outcome = DisplayOutcome::FAILED;
+      result.error = std::current_exception();
+    }
+    complete_(*frame, result);
+  }
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::device_idle_timeout_() -> void {
+  std::lock_guard device_lock(device_mutex_);
+  {
+    // A refresh that finished meanwhile may have pushed the deadline out again.
+    std::lock_guard lock(pending_mutex_);
+    if (!idle_deadline_ || std::chrono::steady_clock::now() < *idle_deadline_) {
+      return;
+    }
+    idle_deadline_.reset();
+  }
+  if (power_state_ != PowerState::ON) {
+    return;
+  }
+
+  try {
+    begin_report_(Operation::IDLE);
+    device_power_off_();
+    if (power_policy_.idle_action == IdleAction::DEEP_SLEEP) {
+      device_deep_sleep_();
+    }
+    end_report_();
+  } catch (const std::exception &e) {
+    std::println(stderr, "e-Paper idle power down failed: {}", e.what());
+  }
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::complete_(PendingFrame &frame, DisplayResult result) -> void {
+  if (frame.on_complete) {
+    frame.on_complete(result);
+  }
+  frame.promise.set_value(std::move(result));
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::device_send_command_(uint8_t command) -> void {
+  transport_->send_command(command);
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::device_send_data_(const uint8_t *data, size_t length) -> void {
+  transport_->send_data({data, length});
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::device_run_(CommandTable table) -> void {
+  for (const auto &entry : table) {
+    device_send_command_(entry.code);
+    if (entry.length > 0) {
+      transport_->send_data(entry.data());
+    }
+    if (entry.delay > 0ms) {
+      std::this_thread::sleep_for(entry.delay);
+    }
+    if (entry.wait_busy) {
+      device_read_busy_();
+    }
+  }
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::device_write_ram_(const uint8_t *data, size_t length) -> void {
+  timed_(Phase::RAM_UPLOAD, [&] {
+    device_send_command_(Panel::CMD_WRITE_RAM);
+    device_send_data_(data, length);
+  });
+  const std::chrono::duration<double> elapsed = report_.phases.back().duration;
+
+  upload_bytes_per_second_ = static_cast<double>(length) / elapsed.count();
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::device_read_busy_() -> void { transport_->wait_busy(BUSY_TIMEOUT); }
+
+template <typename Panel>
+auto EPDDriver<Panel>::device_reset_() -> void {
+  transport_->reset();
+  device_read_busy_();
+  if (Panel::RESET_SETTLE > 0ms) {
+    std::this_thread::sleep_for(Panel::RESET_SETTLE);
+  }
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::device_init_() -> void {
+  begin_report_(Operation::INIT);
+  timed_(Phase::RESET, [this] { device_reset_(); });
+
+  timed_(Phase::INIT_SEQUENCE, [this] { device_init_sequence_(); });
+
+  timed_(Phase::POWER_ON, [this] { device_run_(Panel::POWER_ON); });
+  power_state_ = PowerState::ON;
+  end_report_();
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::device_wake_() -> void {
+  // Deep sleep is only left through a hardware reset, which also drops the configuration.
+  timed_(Phase::RESET, [this] { device_reset_(); });
+  timed_(Phase::INIT_SEQUENCE, [this] { device_init_sequence_(); });
+  power_state_ = PowerState::OFF;
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::device_init_sequence_() -> void { device_run_(Panel::INIT); }
+
+template <typename Panel>
+auto EPDDriver<Panel>::device_turn_on_display_() -> void {
+  if (power_state_ != PowerState::ON) {
+    timed_(Phase::POWER_ON, [this] { device_run_(Panel::POWER_ON); });
+    power_state_ = PowerState::ON;
+  }
+
+  timed_(Phase::REFRESH, [this] { device_run_(Panel::REFRESH); });
+
+  if (power_policy_.hold > 0ms) {
+    // Stay powered so a follow-up frame skips POWER_ON; the worker powers down after the hold.
+    {
+      std::lock_guard lock(pending_mutex_);
+      idle_deadline_ = std::chrono::steady_clock::now() + power_policy_.hold;
+      if (!worker_.joinable()) {
+        start_worker_();
+      }
+    }
+    pending_cv_.notify_one();
+    return;
+  }
+
+  device_power_off_();
+  if (power_policy_.idle_action == IdleAction::DEEP_SLEEP) {
+    device_deep_sleep_();
+  }
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::device_power_off_() -> void {
+  timed_(Phase::POWER_OFF, [this] { device_run_(Panel::POWER_OFF); });
+  power_state_ = PowerState::OFF;
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::device_deep_sleep_() -> void {
+  timed_(Phase::DEEP_SLEEP, [this] { device_run_(Panel::DEEP_SLEEP); });
+  power_state_ = PowerState::SLEEP;
+}
+
+template <typename Panel>
+auto EPDDriver<Panel>::device_sleep_() -> void {
+  if (power_state_ == PowerState::SLEEP) {
+    return;
+  }
+  begin_report_(Operation::SLEEP);
+  if (power_state_ == PowerState::ON) {
+    device_power_off_();
+  }
+  device_deep_sleep_();
+  end_report_();
+}
+
+template class EPDDriver<Panel7in3e>;
+template class EPDDriver<Panel7in3f>;
+template class EPDDriver<Panel7in3g>;
+
+};  // namespace Epaper
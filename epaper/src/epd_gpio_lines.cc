@@ -0,0 +1,119 @@
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "epd_transport_hw.hh"
+
+namespace Epaper {
+
+using namespace std::chrono_literals;
+
+namespace {
+
+auto request_lines(const PinConfig &pins) -> ::gpiod::line_request {
+  ::gpiod::chip chip(pins.gpio_chip);
+  auto output = ::gpiod::line_settings().set_direction(::gpiod::line::direction::OUTPUT);
+  auto builder = chip.prepare_request();
+  builder.set_consumer("get-line-value")
+      .add_line_settings(pins.busy, ::gpiod::line_settings()
+                                        .set_direction(::gpiod::line::direction::INPUT)
+                                        .set_edge_detection(::gpiod::line::edge::RISING))
+      .add_line_settings(pins.rst, output)
+      .add_line_settings(pins.dc, output);
+  return builder.do_request();
+}
+
+// Panels on one Pi share the HAT's power switch, so its line is requested by the first panel that
+// names it and stays on until the last of them goes away.
+struct PowerLine {
+  ::gpiod::line_request request;
+  int users = 0;
+};
+
+std::mutex power_mutex;
+std::map<std::pair<std::filesystem::path, unsigned int>, PowerLine> power_lines;
+
+auto acquire_power(const PinConfig &pins) -> void {
+  std::lock_guard lock(power_mutex);
+  const auto key = std::pair(pins.gpio_chip, *pins.pwr);
+  auto line = power_lines.find(key);
+  if (line == power_lines.end()) {
+    ::gpiod::chip chip(pins.gpio_chip);
+    auto on = ::gpiod::line_settings()
+                  .set_direction(::gpiod::line::direction::OUTPUT)
+                  .set_output_value(::gpiod::line::value::ACTIVE);
+    auto request = chip.prepare_request()
+                       .set_consumer("get-line-value")
+                       .add_line_settings(*pins.pwr, on)
+                       .do_request();
+    line = power_lines.emplace(key, PowerLine{std::move(request)}).first;
+  }
+  ++line->second.users;
+}
+
+auto release_power(const PinConfig &pins) -> void {
+  std::lock_guard lock(power_mutex);
+  auto line = power_lines.find(std::pair(pins.gpio_chip, *pins.pwr));
+  if (line == power_lines.end() || --line->second.users > 0) {
+    return;
+  }
+  line->second.request.set_value(*pins.pwr, gpiod::line::value::INACTIVE);
+  power_lines.erase(line);
+}
+
+}  // namespace
+
+GpioLines::GpioLines(const PinConfig &pins) : pins_(pins), request(request_lines(pins)) {
+  if (pins_.pwr) {
+    acquire_power(pins_);
+  }
+}
+
+GpioLines::~GpioLines() {
+  if (pins_.pwr) {
+    release_power(pins_);
+  }
+  request.set_value(pins_.dc, gpiod::line::value::INACTIVE)
+      .set_value(pins_.rst, gpiod::line::value::INACTIVE);
+}
+
+auto GpioLines::reset() -> void {
+  // Plain sleeps: BUSY edges arrive on this request during reset and would cut an edge wait short.
+  request.set_value(pins_.rst, gpiod::line::value::ACTIVE);
+  std::this_thread::sleep_for(20ms);
+  request.set_value(pins_.rst, gpiod::line::value::INACTIVE);
+  std::this_thread::sleep_for(20ms);
+  request.set_value(pins_.rst, gpiod::line::value::ACTIVE);
+  std::this_thread::sleep_for(20ms);
+}
+
+auto GpioLines::wait_busy(std::chrono::milliseconds timeout) -> void {
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  // BUSY is low while the controller works. A rising edge that lands between the value check and
+  // the wait stays queued in the kernel, so the wait cannot miss it.
+  while (is_busy()) {
+    const auto remaining = deadline - std::chrono::steady_clock::now();
+    if (remaining <= 0ns || !request.wait_edge_events(remaining)) {
+      throw std::runtime_error("Timed out waiting for e-Paper BUSY");
+    }
+  }
+}
+
+auto GpioLines::is_busy() -> bool {
+  while (request.wait_edge_events(0ns)) {
+    request.read_edge_events(events_);
+  }
+  return request.get_value(pins_.busy) == gpiod::line::value::INACTIVE;
+}
+
+auto GpioLines::set_data_mode(bool data) -> void {
+  if (data == data_mode_) {
+    return;
+  }
+  request.set_value(pins_.dc, data ? gpiod::line::value::ACTIVE : gpiod::line::value::INACTIVE);
+  data_mode_ = data;
+}
+
+};  // namespace Epaper
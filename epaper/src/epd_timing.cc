@@ -0,0 +1,96 @@
+#include "epd_timing.hh"
+
+#include <algorithm>
+
+namespace Epaper {
+
+auto to_string(Phase phase) -> std::string_view {
+  switch (phase) {
+    case Phase::RESET:
+      return "reset";
+    case Phase::INIT_SEQUENCE:
+      return "init_sequence";
+    case Phase::RAM_UPLOAD:
+      return "ram_upload";
+    case Phase::POWER_ON:
+      return "power_on";
+    case Phase::REFRESH:
+      return "refresh";
+    case Phase::POWER_OFF:
+      return "power_off";
+    case Phase::DEEP_SLEEP:
+      return "deep_sleep";
+  }
+  return "unknown";
+}
+
+auto to_string(Operation operation) -> std::string_view {
+  switch (operation) {
+    case Operation::INIT:
+      return "init";
+    case Operation::DISPLAY:
+      return "display";
+    case Operation::CLEAR:
+      return "clear";
+    case Operation::SLEEP:
+      return "sleep";
+    case Operation::IDLE:
+      return "idle";
+  }
+  return "unknown";
+}
+
+auto CallReport::duration(Phase phase) const -> std::chrono::nanoseconds {
+  std::chrono::nanoseconds sum{};
+  for (const auto &timing : phases) {
+    if (timing.phase == phase) {
+      sum += timing.duration;
+    }
+  }
+  return sum;
+}
+
+auto PhaseRecorder::record(Phase phase, std::chrono::nanoseconds duration) -> void {
+  std::lock_guard lock(mutex_);
+  auto &counter = counters_[static_cast<size_t>(phase)];
+  counter.window[counter.count % WINDOW] = duration;
+  ++counter.count;
+  counter.min = std::min(counter.min, duration);
+  counter.max = std::max(counter.max, duration);
+  counter.sum += duration;
+}
+
+auto PhaseRecorder::stats(Phase phase) const -> PhaseStats {
+  std::lock_guard lock(mutex_);
+  return summarize_(counters_[static_cast<size_t>(phase)]);
+}
+
+auto PhaseRecorder::snapshot() const -> std::array<PhaseStats, PHASE_COUNT> {
+  std::lock_guard lock(mutex_);
+  std::array<PhaseStats, PHASE_COUNT> result;
+  for (size_t i = 0; i < PHASE_COUNT; ++i) {
+    result[i] = summarize_(counters_[i]);
+  }
+  return result;
+}
+
+auto PhaseRecorder::summarize_(const Counter &counter) -> PhaseStats {
+  if (counter.count == 0) {
+    return {};
+  }
+  const auto samples = static_cast<size_t>(std::min<uint64_t>(counter.count, WINDOW));
+  std::array<std::chrono::nanoseconds, WINDOW> sorted = counter.window;
+  const auto rank = (samples * 99 + 99) / 100 - 1;  // nearest-rank percentile
+  std::nth_element(sorted.begin(), sorted.begin() + static_cast<ptrdiff_t>(rank),
+                   sorted.begin() + static_cast<ptrdiff_t>(samples));
+
+  return {
+      .count = counter.count,
+      .min = counter.min,
+      .avg = counter.sum / static_cast<int64_t>(counter.count),
+      .max = counter.max,
+      .p99 = sorted[rank],
+  };
+}
+
+};  // namespace Epaper
@@ -0,0 +1,42 @@
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "epd_transport.hh"
+#include "epd_transport_sim.hh"
+
+#ifdef EPAPER_HAVE_GPIOD
+#include "epd_transport_hw.hh"
+#endif
+
+namespace Epaper {
+
+auto make_transport([[maybe_unused]] const PinConfig &pins, const PanelFormat &panel)
+    -> std::unique_ptr<Transport> {
+  const char *env = std::getenv("EPAPER_TRANSPORT");
+#if defined(EPAPER_HAVE_BCM2835)
+  const std::string_view name = env != nullptr ? env : "bcm2835";
+#elif defined(EPAPER_HAVE_GPIOD)
+  const std::string_view name = env != nullptr ? env : "spidev";
+#else
+  const std::string_view name = env != nullptr ? env : "sim";
+#endif
+
+#ifdef EPAPER_HAVE_BCM2835
+  if (name == "bcm2835") {
+    return std::make_unique<Bcm2835Transport>(pins);
+  }
+#endif
+#ifdef EPAPER_HAVE_GPIOD
+  if (name == "spidev") {
+    return std::make_unique<SpidevTransport>(pins);
+  }
+#endif
+  if (name == "sim") {
+    return make_simulated_transport(panel);
+  }
+  throw std::invalid_argument("Unsupported EPAPER_TRANSPORT: " + std::string(name));
+}
+
+};  // namespace Epaper
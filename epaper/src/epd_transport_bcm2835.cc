@@ -0,0 +1,62 @@
+#include <bcm2835.h>
+
+#include <mutex>
+#include <stdexcept>
+
+#include "epd_transport_hw.hh"
+
+namespace Epaper {
+
+namespace {
+
+// bcm2835_init() maps the peripherals once per process and the chip select is global SPI state, so
+// transports on different chip selects share this lock and an init refcount.
+std::mutex bus_mutex;
+int bus_users = 0;
+
+}  // namespace
+
+Bcm2835Transport::Bcm2835Transport(const PinConfig &pins)
+    : lines_(pins),
+      chip_select_(pins.chip_select == 1 ? BCM2835_SPI_CS1 : BCM2835_SPI_CS0) {
+  std::lock_guard lock(bus_mutex);
+  if (bus_users == 0) {
+    if (bcm2835_init() != 1) {
+      throw std::runtime_error("Failed to initialize SPI");
+    }
+    bcm2835_spi_begin();
+    bcm2835_spi_setDataMode(BCM2835_SPI_MODE0);
+    bcm2835_spi_setBitOrder(BCM2835_SPI_BIT_ORDER_MSBFIRST);
+    bcm2835_spi_set_speed_hz(10000000);
+  }
+  ++bus_users;
+}
+
+Bcm2835Transport::~Bcm2835Transport() {
+  std::lock_guard lock(bus_mutex);
+  if (--bus_users == 0) {
+    bcm2835_spi_end();
+    bcm2835_close();
+  }
+}
+
+auto Bcm2835Transport::send_command(uint8_t command) -> void {
+  std::lock_guard lock(bus_mutex);
+  lines_.set_data_mode(false);
+  bcm2835_spi_chipSelect(chip_select_);
+  bcm2835_spi_transfer(command);                // Send command via SPI
+  bcm2835_spi_chipSelect(BCM2835_SPI_CS_NONE);  // Set chip select to none
+}
+
+auto Bcm2835Transport::send_data(std::span<const uint8_t> data) -> void {
+  // DC and CS are set once for the whole burst; the SPI block then streams the buffer through the
+  // FIFO without per-byte GPIO ioctls.
+  std::lock_guard lock(bus_mutex);
+  lines_.set_data_mode(true);
+  bcm2835_spi_chipSelect(chip_select_);
+  bcm2835_spi_writenb(reinterpret_cast<const char *>(data.data()),
+                      static_cast<uint32_t>(data.size()));
+  bcm2835_spi_chipSelect(BCM2835_SPI_CS_NONE);
+}
+
+};  // namespace Epaper
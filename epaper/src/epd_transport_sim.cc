@@ -0,0 +1,226 @@
+#include <stb/stb_image_write.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdlib>
+#include <print>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+#include "epd_transport_sim.hh"
+
+namespace Epaper {
+
+namespace {
+
+// Colour indices the panel's palette does not cover, so driver bugs stand out.
+constexpr std::array<uint8_t, 3> UNUSED_RGB = {0xFF, 0x00, 0xFF};
+
+}  // namespace
+
+auto SimulatedTimings::scaled(double factor) const -> SimulatedTimings {
+  auto scale = [factor](std::chrono::milliseconds duration) {
+    return std::chrono::milliseconds(
+        static_cast<int64_t>(static_cast<double>(duration.count()) * factor));
+  };
+  return {scale(reset), scale(power_on), scale(refresh), scale(power_off)};
+}
+
+SimulatedTransport::SimulatedTransport(SimulatedTimings timings, ::std::filesystem::path png_path,
+                                       PanelFormat panel)
+    : panel_(panel),
+      timings_(timings),
+      png_path_(std::move(png_path)),
+      timer_fd_(::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC)),
+      ram_(static_cast<size_t>(panel.width * panel.bits_per_pixel / 8) * panel.height),
+      displayed_(ram_.size()) {
+  if (timer_fd_ < 0) {
+    throw std::system_error(errno, std::generic_category(), "timerfd_create failed");
+  }
+}
+
+SimulatedTransport::~SimulatedTransport() { ::close(timer_fd_); }
+
+auto SimulatedTransport::reset() -> void {
+  std::lock_guard lock(mutex_);
+  powered_ = false;
+  sleeping_ = false;
+  command_ = CMD_PANEL_SETTING;
+  start_busy_(timings_.reset);
+}
+
+auto SimulatedTransport::send_command(uint8_t command) -> void {
+  std::lock_guard lock(mutex_);
+  if (sleeping_) {
+    protocol_error_("command while in deep sleep");
+    return;
+  }
+  if (busy_()) {
+    protocol_error_("command while BUSY");
+  }
+  command_ = command;
+
+  switch (command) {
+    case CMD_WRITE_RAM:
+      ram_offset_ = 0;
+      break;
+    case CMD_POWER_ON:
+      powered_ = true;
+      start_busy_(timings_.power_on);
+      break;
+    case CMD_POWER_OFF:
+      powered_ = false;
+      start_busy_(timings_.power_off);
+      break;
+    case CMD_DISPLAY_REFRESH:
+      if (!powered_) {
+        protocol_error_("refresh without POWER_ON");
+        break;
+      }
+      displayed_ = ram_;
+      ++refresh_count_;
+      start_busy_(timings_.refresh);
+      if (!png_path_.empty()) {
+        write_png_(png_path_);
+      }
+      break;
+    default:
+      registers_[command].clear();
+      break;
+  }
+}
+
+auto SimulatedTransport::send_data(std::span<const uint8_t> data) -> void {
+  std::lock_guard lock(mutex_);
+  if (sleeping_) {
+    protocol_error_("data while in deep sleep");
+    return;
+  }
+
+  switch (command_) {
+    case CMD_WRITE_RAM: {
+      if (ram_offset_ + data.size() > ram_.size()) {
+        protocol_error_("RAM write past end of frame");
+        data = data.first(ram_.size() - ram_offset_);
+      }
+      std::ranges::copy(data, ram_.begin() + static_cast<ptrdiff_t>(ram_offset_));
+      ram_offset_ += data.size();
+      break;
+    }
+    case CMD_DEEP_SLEEP:
+      if (!data.empty() && data.front() == DEEP_SLEEP_CHECK) {
+        sleeping_ = true;
+        powered_ = false;
+      }
+      break;
+    case CMD_POWER_ON:
+    case CMD_POWER_OFF:
+    case CMD_DISPLAY_REFRESH:
+      break;
+    default: {
+      auto &value = registers_[command_];
+      value.insert(value.end(), data.begin(), data.end());
+      break;
+    }
+  }
+}
+
+auto SimulatedTransport::wait_busy(std::chrono::milliseconds timeout) -> void {
+  std::chrono::steady_clock::time_point until;
+  {
+    std::lock_guard lock(mutex_);
+    until = busy_until_;
+  }
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  if (until > deadline) {
+    std::this_thread::sleep_until(deadline);
+    throw std::runtime_error("Timed out waiting for e-Paper BUSY");
+  }
+  std::this_thread::sleep_until(until);
+}
+
+auto SimulatedTransport::is_busy() -> bool {
+  uint64_t expirations = 0;
+  [[maybe_unused]] auto drained = ::read(timer_fd_, &expirations, sizeof(expirations));
+  std::lock_guard lock(mutex_);
+  return busy_();
+}
+
+auto SimulatedTransport::displayed_frame() const -> std::vector<uint8_t> {
+  std::lock_guard lock(mutex_);
+  return displayed_;
+}
+
+auto SimulatedTransport::register_value(uint8_t command) const -> std::vector<uint8_t> {
+  std::lock_guard lock(mutex_);
+  auto it = registers_.find(command);
+  return it != registers_.end() ? it->second : std::vector<uint8_t>{};
+}
+
+auto SimulatedTransport::refresh_count() const -> size_t {
+  std::lock_guard lock(mutex_);
+  return refresh_count_;
+}
+
+auto SimulatedTransport::protocol_errors() const -> size_t {
+  std::lock_guard lock(mutex_);
+  return protocol_errors_;
+}
+
+auto SimulatedTransport::write_png(const ::std::filesystem::path &path) const -> void {
+  std::lock_guard lock(mutex_);
+  write_png_(path);
+}
+
+auto SimulatedTransport::busy_() const -> bool {
+  return std::chrono::steady_clock::now() < busy_until_;
+}
+
+auto SimulatedTransport::start_busy_(std::chrono::milliseconds duration) -> void {
+  busy_until_ = std::chrono::steady_clock::now() + duration;
+
+  // A zero it_value would disarm the timer, so an instant busy period still fires after 1 ns.
+  const auto ns = std::max<int64_t>(std::chrono::nanoseconds(duration).count(), 1);
+  itimerspec spec{};
+  spec.it_value.tv_sec = static_cast<time_t>(ns / 1000000000);
+  spec.it_value.tv_nsec = static_cast<long>(ns % 1000000000);
+  ::timerfd_settime(timer_fd_, 0, &spec, nullptr);
+}
+
+auto SimulatedTransport::protocol_error_(const char *what) -> void {
+  ++protocol_errors_;
+  std::println(stderr, "[epaper-sim] protocol error: {} (command 0x{:02X})", what, command_);
+}
+
+auto SimulatedTransport::write_png_(const ::std::filesystem::path &path) const -> void {
+  const int bpp = panel_.bits_per_pixel;
+  const auto mask = static_cast<uint8_t>((1U << bpp) - 1);
+  std::vector<uint8_t> rgb(static_cast<size_t>(panel_.width) * panel_.height * 3);
+  auto out = rgb.begin();
+  for (const uint8_t byte : displayed_) {
+    for (int shift = 8 - bpp; shift >= 0; shift -= bpp) {
+      const size_t index = (byte >> shift) & mask;
+      const auto &color = index < panel_.palette.size() ? panel_.palette[index] : UNUSED_RGB;
+      out = std::ranges::copy(color, out).out;
+    }
+  }
+  if (stbi_write_png(path.c_str(), panel_.width, panel_.height, 3, rgb.data(), panel_.width * 3) ==
+      0) {
+    std::println(stderr, "[epaper-sim] failed to write {}", path.string());
+  }
+}
+
+auto make_simulated_transport(const PanelFormat &panel) -> std::unique_ptr<SimulatedTransport> {
+  SimulatedTimings timings;
+  if (const char *scale = std::getenv("EPAPER_SIM_TIME_SCALE")) {
+    timings = timings.scaled(std::strtod(scale, nullptr));
+  }
+  const char *png = std::getenv("EPAPER_SIM_PNG");
+  return std::make_unique<SimulatedTransport>(timings, png != nullptr ? png : "", panel);
+}
+
+};  // namespace Epaper
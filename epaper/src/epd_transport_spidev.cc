@@ -0,0 +1,93 @@
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <fstream>
+#include <string>
+#include <system_error>
+
+#include "epd_transport_hw.hh"
+
+namespace Epaper {
+
+namespace {
+
+constexpr auto BUFSIZ_PARAMETER = "/sys/module/spidev/parameters/bufsiz";
+
+// Upper bound on the bytes spidev accepts in one SPI_IOC_MESSAGE, 4096 unless the module was
+// loaded with a larger spidev.bufsiz.
+auto read_spidev_bufsiz() -> size_t {
+  std::ifstream file(BUFSIZ_PARAMETER);
+  size_t bufsiz = 0;
+  if (!(file >> bufsiz) || bufsiz == 0) {
+    return 4096;
+  }
+  return bufsiz;
+}
+
+auto spi_ioc_message(size_t count) -> unsigned long {
+  // SPI_IOC_MESSAGE(N) with a runtime N.
+  return _IOC(_IOC_WRITE, SPI_IOC_MAGIC, 0, count * sizeof(spi_ioc_transfer));
+}
+
+}  // namespace
+
+SpidevTransport::SpidevTransport(const PinConfig &pins) : lines_(pins) {
+  // The kernel serialises messages from several spidev handles on one controller.
+  const ::std::filesystem::path device = "/dev/spidev0." + std::to_string(pins.chip_select);
+  fd_ = ::open(device.c_str(), O_RDWR | O_CLOEXEC);
+  if (fd_ < 0) {
+    throw std::system_error(errno, std::generic_category(), "Failed to open " + device.string());
+  }
+
+  uint8_t mode = SPI_MODE_0;
+  uint8_t bits = 8;
+  uint32_t speed = SPEED_HZ;
+  if (::ioctl(fd_, SPI_IOC_WR_MODE, &mode) < 0 ||
+      ::ioctl(fd_, SPI_IOC_WR_BITS_PER_WORD, &bits) < 0 ||
+      ::ioctl(fd_, SPI_IOC_WR_MAX_SPEED_HZ, &speed) < 0) {
+    auto error = errno;
+    ::close(fd_);
+    throw std::system_error(error, std::generic_category(), "Failed to configure SPI");
+  }
+
+  const auto bufsiz = read_spidev_bufsiz();
+  segment_size_ = std::min(MAX_SEGMENT_SIZE, bufsiz);
+  segments_per_message_ = std::clamp<size_t>(bufsiz / segment_size_, 1, MAX_SEGMENTS_PER_MESSAGE);
+  transfers_.resize(segments_per_message_);
+}
+
+SpidevTransport::~SpidevTransport() { ::close(fd_); }
+
+auto SpidevTransport::send_command(uint8_t command) -> void {
+  lines_.set_data_mode(false);
+  write_({&command, 1});
+}
+
+auto SpidevTransport::send_data(std::span<const uint8_t> data) -> void {
+  lines_.set_data_mode(true);
+  write_(data);
+}
+
+auto SpidevTransport::write_(std::span<const uint8_t> data) -> void {
+  while (!data.empty()) {
+    size_t count = 0;
+    for (; count < segments_per_message_ && !data.empty(); ++count) {
+      const auto length = std::min(segment_size_, data.size());
+      auto &transfer = transfers_[count];
+      transfer = {};
+      transfer.tx_buf = reinterpret_cast<uintptr_t>(data.data());
+      transfer.len = static_cast<uint32_t>(length);
+      transfer.speed_hz = SPEED_HZ;
+      transfer.bits_per_word = 8;
+      data = data.subspan(length);
+    }
+    if (::ioctl(fd_, spi_ioc_message(count), transfers_.data()) < 0) {
+      throw std::system_error(errno, std::generic_category(), "SPI_IOC_MESSAGE failed");
+    }
+  }
+}
+
+};  // namespace Epaper
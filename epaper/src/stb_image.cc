@@ -0,0 +1,4 @@
+// stb_image_write is used by the simulated panel to dump frames. Only the writer is implemented
+// here; apps that decode images define STB_IMAGE_IMPLEMENTATION themselves.
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb/stb_image_write.h>
@@ -38,6 +38,7 @@
                 pkgs.openssl
                 pkgs.grpc
                 pkgs.qt6Packages.qtbase
+                pkgs.gtest
 
                 stb_image
               ]
@@ -63,6 +64,7 @@
                 pkgs.pkg-config
                 pkgs.qt6Packages.wrapQtAppsHook
               ];
+              cmakeFlags = [ "-DBUILD_TESTING=OFF" ];
               buildInputs =
                 [
                   pkgs.protobuf
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <ctime>
+
+#include "cron_window.hh"
+
+namespace {
+
+// Local time on 2024-01-01, a Monday, or a later day in January.
+auto at(int day, int hour, int minute) -> std::chrono::system_clock::time_point {
+  std::tm local{};
+  local.tm_year = 2024 - 1900;
+  local.tm_mon = 0;
+  local.tm_mday = day;
+  local.tm_hour = hour;
+  local.tm_min = minute;
+  local.tm_isdst = -1;
+  return std::chrono::system_clock::from_time_t(std::mktime(&local));
+}
+
+TEST(CronWindowTest, EmptySpecMatchesEveryMinute) {
+  const auto window = CronWindow::parse("  ");
+  ASSERT_TRUE(window.has_value());
+  EXPECT_TRUE(window->contains(at(1, 0, 0)));
+  EXPECT_TRUE(window->contains(at(7, 23, 59)));
+}
+
+TEST(CronWindowTest, MatchesRangesListsAndSteps) {
+  const auto window = CronWindow::parse("*/15 9-17 * * 1-5");
+  ASSERT_TRUE(window.has_value());
+  EXPECT_TRUE(window->contains(at(1, 9, 0)));
+  EXPECT_TRUE(window->contains(at(1, 17, 45)));
+  EXPECT_FALSE(window->contains(at(1, 9, 10)));
+  EXPECT_FALSE(window->contains(at(1, 18, 0)));
+  EXPECT_FALSE(window->contains(at(6, 9, 0)));  // Saturday
+
+  const auto list = CronWindow::parse("0,30 8,20 * * *");
+  ASSERT_TRUE(list.has_value());
+  EXPECT_TRUE(list->contains(at(3, 20, 30)));
+  EXPECT_FALSE(list->contains(at(3, 12, 30)));
+}
+
+TEST(CronWindowTest, SundayIsZeroOrSeven) {
+  const auto window = CronWindow::parse("* * * * 7");
+  ASSERT_TRUE(window.has_value());
+  EXPECT_TRUE(window->contains(at(7, 12, 0)));
+  EXPECT_FALSE(window->contains(at(8, 12, 0)));
+}
+
+TEST(CronWindowTest, RestrictedDayFieldsMatchEither) {
+  const auto either = CronWindow::parse("* * 10 * 1");
+  ASSERT_TRUE(either.has_value());
+  EXPECT_TRUE(either->contains(at(10, 12, 0)));  // Wednesday the 10th
+  EXPECT_TRUE(either->contains(at(8, 12, 0)));   // Monday the 8th
+  EXPECT_FALSE(either->contains(at(9, 12, 0)));
+
+  // With the weekday unrestricted only the day of the month counts.
+  const auto day = CronWindow::parse("* * 10 * *");
+  ASSERT_TRUE(day.has_value());
+  EXPECT_TRUE(day->contains(at(10, 12, 0)));
+  EXPECT_FALSE(day->contains(at(8, 12, 0)));
+}
+
+TEST(CronWindowTest, RejectsInvalidSpecs) {
+  for (const char* spec :
+       {"* * * *", "* * * * * *", "60 * * * *", "* 24 * * *", "* * 0 * *", "* * * 13 *",
+        "* * * * 8", "5-1 * * * *", "*/0 * * * *", "1,,2 * * * *", "a * * * *", "1- * * * *"}) {
+    EXPECT_FALSE(CronWindow::parse(spec).has_value()) << spec;
+  }
+}
+
+}  // namespace
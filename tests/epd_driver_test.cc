@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "epd_driver.hh"
+#include "epd_transport_sim.hh"
+
+namespace Epaper {
+namespace {
+
+using Driver = EPDDriver<Panel7in3e>;
+
+auto frame_of(Panel7in3e::Color color) -> std::vector<uint8_t> {
+  return std::vector<uint8_t>(Driver::FRAME_BYTES, fill_byte<Panel7in3e>(color));
+}
+
+auto ran(const DisplayResult &result, Phase phase) -> bool {
+  return std::ranges::any_of(result.report.phases,
+                             [phase](const PhaseTiming &timing) { return timing.phase == phase; });
+}
+
+// A driver on an instant simulated panel.
+class DriverTest : public ::testing::Test {
+ protected:
+  DriverTest() {
+    auto transport = std::make_unique<SimulatedTransport>(SimulatedTimings{}.scaled(0));
+    sim_ = transport.get();
+    driver_ = std::make_unique<Driver>(std::move(transport));
+    driver_->set_shutdown_policy(ShutdownPolicy::SLEEP);
+  }
+
+  // Every test must stay within what a real controller accepts.
+  void TearDown() override { EXPECT_EQ(sim_->protocol_errors(), 0U); }
+
+  // Queues a red frame whose producer keeps the worker busy until `release` is ready, and returns
+  // once the worker has taken it.
+  auto occupy_worker(std::shared_future<void> release) -> std::future<DisplayResult> {
+    auto started = std::make_shared<std::promise<void>>();
+    auto taken = started->get_future();
+    auto result = driver_->display_stream_async(
+        [started, release](int row, std::span<uint8_t> packed_row) {
+          if (row == 0) {
+            started->set_value();
+            release.wait();
+          }
+          std::ranges::fill(packed_row, fill_byte<Panel7in3e>(Panel7in3e::Color::RED));
+          return true;
+        });
+    taken.wait();
+    return result;
+  }
+
+  SimulatedTransport *sim_ = nullptr;  // owned by driver_
+  std::unique_ptr<Driver> driver_;
+};
+
+TEST_F(DriverTest, SkipsFrameAlreadyOnGlass) {
+  const auto red = frame_of(Panel7in3e::Color::RED);
+  EXPECT_EQ(driver_->display(red).outcome, DisplayOutcome::DISPLAYED);
+  EXPECT_EQ(driver_->display(red).outcome, DisplayOutcome::SKIPPED);
+  EXPECT_EQ(sim_->refresh_count(), 1U);
+  EXPECT_EQ(sim_->displayed_frame(), red);
+
+  const auto blue = frame_of(Panel7in3e::Color::BLUE);
+  EXPECT_EQ(driver_->display(blue).outcome, DisplayOutcome::DISPLAYED);
+  EXPECT_EQ(sim_->refresh_count(), 2U);
+}
+
+TEST_F(DriverTest, SkippedStreamReportsItsUpload) {
+  auto red_rows = [](int, std::span<uint8_t> packed_row) {
+    std::ranges::fill(packed_row, fill_byte<Panel7in3e>(Panel7in3e::Color::RED));
+    return true;
+  };
+  driver_->display(frame_of(Panel7in3e::Color::RED));
+
+  const auto skipped = driver_->display_stream(red_rows);
+  EXPECT_EQ(skipped.outcome, DisplayOutcome::SKIPPED);
+  EXPECT_TRUE(ran(skipped, Phase::RAM_UPLOAD));
+  EXPECT_FALSE(ran(skipped, Phase::REFRESH));
+  EXPECT_EQ(driver_->last_report(Operation::DISPLAY).start, skipped.report.start);
+}
+
+TEST_F(DriverTest, RefreshesAfterInvalidate) {
+  const auto red = frame_of(Panel7in3e::Color::RED);
+  driver_->display(red);
+  driver_->invalidate_displayed();
+  EXPECT_EQ(driver_->display(red).outcome, DisplayOutcome::DISPLAYED);
+
+  driver_->set_skip_identical(false);
+  EXPECT_EQ(driver_->display(red).outcome, DisplayOutcome::DISPLAYED);
+  EXPECT_EQ(sim_->refresh_count(), 3U);
+}
+
+TEST_F(DriverTest, SkipsFrameDeclaredDisplayed) {
+  const auto red = frame_of(Panel7in3e::Color::RED);
+  driver_->display(red);
+  const auto hash = driver_->displayed_hash();
+  ASSERT_TRUE(hash.has_value());
+
+  driver_->display(frame_of(Panel7in3e::Color::GREEN));
+  driver_->set_displayed_hash(*hash);
+  EXPECT_EQ(driver_->display(red).outcome, DisplayOutcome::SKIPPED);
+}
+
+TEST_F(DriverTest, PowersOffAfterEachRefreshWithoutHold) {
+  // Init leaves the booster on, so the first frame only powers off.
+  EXPECT_EQ(driver_->power_state(), PowerState::ON);
+  const auto first = driver_->display(frame_of(Panel7in3e::Color::RED));
+  EXPECT_FALSE(ran(first, Phase::POWER_ON));
+  EXPECT_TRUE(ran(first, Phase::POWER_OFF));
+  EXPECT_EQ(driver_->power_state(), PowerState::OFF);
+
+  const auto second = driver_->display(frame_of(Panel7in3e::Color::BLUE));
+  EXPECT_TRUE(ran(second, Phase::POWER_ON));
+  EXPECT_TRUE(ran(second, Phase::POWER_OFF));
+  EXPECT_EQ(driver_->power_state(), PowerState::OFF);
+}
+
+TEST_F(DriverTest, HoldKeepsPowerForNextFrame) {
+  driver_->set_power_policy({.hold = std::chrono::milliseconds(200)});
+  driver_->display(frame_of(Panel7in3e::Color::RED));
+  EXPECT_EQ(driver_->power_state(), PowerState::ON);
+
+  const auto second = driver_->display(frame_of(Panel7in3e::Color::BLUE));
+  EXPECT_FALSE(ran(second, Phase::POWER_ON));
+  EXPECT_FALSE(ran(second, Phase::POWER_OFF));
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(400));
+  EXPECT_EQ(driver_->power_state(), PowerState::OFF);
+}
+
+TEST_F(DriverTest, HoldExpiresAfterIdleWorkerWakes) {
+  driver_->set_power_policy({.hold = std::chrono::milliseconds(50)});
+  driver_->display(frame_of(Panel7in3e::Color::RED));
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  EXPECT_EQ(driver_->power_state(), PowerState::OFF);
+
+  // The worker is now waiting without a deadline; the next hold must still run out.
+  driver_->display(frame_of(Panel7in3e::Color::BLUE));
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  EXPECT_EQ(driver_->power_state(), PowerState::OFF);
+}
+
+TEST_F(DriverTest, IdleDeepSleepWakesForNextFrame) {
+  driver_->set_power_policy(
+      {.hold = std::chrono::milliseconds(20), .idle_action = IdleAction::DEEP_SLEEP});
+  driver_->display(frame_of(Panel7in3e::Color::RED));
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  EXPECT_EQ(driver_->power_state(), PowerState::SLEEP);
+
+  const auto blue = frame_of(Panel7in3e::Color::BLUE);
+  EXPECT_EQ(driver_->display(blue).outcome, DisplayOutcome::DISPLAYED);
+  EXPECT_EQ(sim_->displayed_frame(), blue);
+}
+
+TEST_F(DriverTest, ClearWakesSleepingPanel) {
+  driver_->set_power_policy({.idle_action = IdleAction::DEEP_SLEEP});
+  driver_->display(frame_of(Panel7in3e::Color::RED));
+  EXPECT_EQ(driver_->power_state(), PowerState::SLEEP);
+
+  driver_->clear(Panel7in3e::Color::WHITE);
+  EXPECT_EQ(sim_->displayed_frame(), frame_of(Panel7in3e::Color::WHITE));
+}
+
+TEST_F(DriverTest, NewerAsyncFrameSupersedesWaitingOne) {
+  std::promise<void> release;
+  auto busy = occupy_worker(release.get_future().share());
+
+  auto superseded = driver_->display_async(frame_of(Panel7in3e::Color::BLUE));
+  const auto green = frame_of(Panel7in3e::Color::GREEN);
+  auto latest = driver_->display_async(green);
+  EXPECT_EQ(superseded.get().outcome, DisplayOutcome::SUPERSEDED);
+
+  release.set_value();
+  EXPECT_EQ(busy.get().outcome, DisplayOutcome::DISPLAYED);
+  EXPECT_EQ(latest.get().outcome, DisplayOutcome::DISPLAYED);
+  EXPECT_EQ(sim_->displayed_frame(), green);
+  EXPECT_EQ(sim_->refresh_count(), 2U);
+}
+
+TEST_F(DriverTest, CancelPendingCompletesFrame) {
+  std::promise<void> release;
+  auto busy = occupy_worker(release.get_future().share());
+
+  auto waiting = driver_->display_async(frame_of(Panel7in3e::Color::BLUE));
+  EXPECT_TRUE(driver_->cancel_pending());
+  EXPECT_EQ(waiting.get().outcome, DisplayOutcome::CANCELLED);
+  EXPECT_FALSE(driver_->cancel_pending());
+
+  release.set_value();
+  EXPECT_EQ(busy.get().outcome, DisplayOutcome::DISPLAYED);
+}
+
+}  // namespace
+}  // namespace Epaper
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "frame_codec.hh"
+
+namespace Apps::Common {
+namespace {
+
+constexpr size_t FRAME_BYTES = 800 / 2 * 480;
+
+// A packed 4bpp frame of random panel colours, in runs of 1..`max_run` pixels.
+auto random_frame(size_t max_run, uint32_t seed) -> std::vector<uint8_t> {
+  std::mt19937 random(seed);
+  std::uniform_int_distribution<size_t> color(0, BASE6_COLORS.size() - 1);
+  std::uniform_int_distribution<size_t> length(1, max_run);
+  std::vector<uint8_t> frame(FRAME_BYTES);
+  size_t pixel = 0;
+  while (pixel < FRAME_BYTES * 2) {
+    const auto nibble = static_cast<uint8_t>(BASE6_COLORS[color(random)]);
+    for (size_t run = length(random); run > 0 && pixel < FRAME_BYTES * 2; --run, ++pixel) {
+      auto& byte = frame[pixel / 2];
+      byte = pixel % 2 == 0 ? static_cast<uint8_t>(nibble << 4) : byte | nibble;
+    }
+  }
+  return frame;
+}
+
+auto round_trip(const std::vector<uint8_t>& frame) -> std::vector<uint8_t> {
+  const auto encoded = encode_base6_rle(frame);
+  EXPECT_TRUE(encoded.has_value());
+  EXPECT_LE(encoded->size(), frame.size() * 2 / 3 + 1);
+  std::vector<uint8_t> decoded(frame.size());
+  EXPECT_TRUE(decode_base6_rle(*encoded, decoded));
+  return decoded;
+}
+
+TEST(Base6RleTest, RoundTripsFlatFrame) {
+  const std::vector<uint8_t> white(FRAME_BYTES, 0x11);
+  EXPECT_EQ(round_trip(white), white);
+  EXPECT_LT(encode_base6_rle(white)->size(), 8U);
+}
+
+TEST(Base6RleTest, RoundTripsDitheredAndBlockyFrames) {
+  for (const size_t max_run : {1, 3, 7, 40, 5000}) {
+    const auto frame = random_frame(max_run, static_cast<uint32_t>(max_run));
+    EXPECT_EQ(round_trip(frame), frame) << "runs up to " << max_run;
+  }
+}
+
+TEST(Base6RleTest, RoundTripsOddSizes) {
+  for (const size_t size : {1, 2, 3, 4, 5}) {
+    auto frame = random_frame(2, static_cast<uint32_t>(size));
+    frame.resize(size);
+    EXPECT_EQ(round_trip(frame), frame) << size << " bytes";
+  }
+}
+
+TEST(Base6RleTest, RejectsColourOutsidePalette) {
+  std::vector<uint8_t> frame(FRAME_BYTES, 0x11);
+  frame[100] = 0x14;
+  EXPECT_FALSE(encode_base6_rle(frame).has_value());
+}
+
+TEST(Base6RleTest, RejectsMalformedInput) {
+  const auto frame = random_frame(10, 1);
+  const auto encoded = *encode_base6_rle(frame);
+  std::vector<uint8_t> decoded(frame.size());
+
+  EXPECT_FALSE(decode_base6_rle(std::span(encoded).first(encoded.size() / 2), decoded));
+  auto longer = encoded;
+  longer.push_back(0);
+  EXPECT_FALSE(decode_base6_rle(longer, decoded));
+  EXPECT_FALSE(decode_base6_rle(std::vector<uint8_t>{BASE6_RUN + 6, 0}, decoded));
+  // A run longer than the frame.
+  EXPECT_FALSE(decode_base6_rle(std::vector<uint8_t>{BASE6_RUN, 0xFF, 0xFF, 0x7F}, decoded));
+}
+
+TEST(XorDeltaTest, AppliesDiffToBase) {
+  const auto base = random_frame(40, 1);
+  auto frame = base;
+  const size_t changed[] = {0, 5, 9, 1000, 1001, 60000, FRAME_BYTES - 1};
+  for (const size_t i : changed) {
+    frame[i] ^= 0x33;
+  }
+
+  const auto ranges = diff_frames(base, frame);
+  EXPECT_EQ(ranges.size(), 4U);  // 0..9 merge, as do 1000..1001
+  auto patched = base;
+  for (const auto& range : ranges) {
+    EXPECT_TRUE(apply_xor(patched, range.offset, range.bits));
+  }
+  EXPECT_EQ(patched, frame);
+}
+
+TEST(XorDeltaTest, IdenticalFramesHaveNoRanges) {
+  const auto frame = random_frame(40, 2);
+  EXPECT_TRUE(diff_frames(frame, frame).empty());
+}
+
+TEST(XorDeltaTest, RejectsRangePastEnd) {
+  std::vector<uint8_t> frame(16);
+  const std::vector<uint8_t> bits(4, 0xFF);
+  EXPECT_FALSE(apply_xor(frame, 13, bits));
+  EXPECT_FALSE(apply_xor(frame, 17, {}));
+  EXPECT_TRUE(apply_xor(frame, 12, bits));
+}
+
+}  // namespace
+}  // namespace Apps::Common
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <optional>
+#include <vector>
+
+#include "frame_queue.hh"
+
+namespace {
+
+using Queue = FrameQueue<int>;
+using std::chrono::seconds;
+
+const Queue::Clock::time_point NOW{seconds(1000)};
+
+auto entry(uint32_t priority, int item) -> Queue::Entry {
+  return {.priority = priority, .submitted = NOW, .expires = {}, .start = {}, .item = item};
+}
+
+auto push(Queue& queue, Queue::Entry e) -> std::vector<int> {
+  std::vector<Queue::Entry> displaced;
+  EXPECT_FALSE(queue.push(std::move(e), displaced).has_value());
+  std::vector<int> items;
+  for (const auto& d : displaced) {
+    items.push_back(d.item);
+  }
+  return items;
+}
+
+auto pop_item(Queue& queue, Queue::Clock::time_point now = NOW,
+              Queue::Clock::duration runtime = seconds(30)) -> std::optional<int> {
+  auto e = queue.pop(now, runtime);
+  return e ? std::optional(e->item) : std::nullopt;
+}
+
+TEST(FrameQueueTest, ServesHighestPriorityFirst) {
+  Queue queue(4);
+  push(queue, entry(1, 10));
+  push(queue, entry(5, 50));
+  push(queue, entry(3, 30));
+  EXPECT_EQ(pop_item(queue), 50);
+  EXPECT_EQ(pop_item(queue), 30);
+  EXPECT_EQ(pop_item(queue), 10);
+  EXPECT_EQ(pop_item(queue), std::nullopt);
+}
+
+TEST(FrameQueueTest, LatestFrameWinsWithinPriority) {
+  Queue queue(4);
+  push(queue, entry(1, 10));
+  EXPECT_EQ(push(queue, entry(1, 11)), std::vector<int>{10});
+  EXPECT_EQ(queue.size(), 1U);
+  EXPECT_EQ(pop_item(queue), 11);
+}
+
+TEST(FrameQueueTest, TimedAndUntimedFramesDoNotReplaceEachOther) {
+  Queue queue(4);
+  auto timed = entry(1, 10);
+  timed.start = NOW + seconds(60);
+  push(queue, std::move(timed));
+  EXPECT_TRUE(push(queue, entry(1, 11)).empty());
+  EXPECT_EQ(queue.size(), 2U);
+
+  auto retimed = entry(1, 12);
+  retimed.start = NOW + seconds(90);
+  EXPECT_EQ(push(queue, std::move(retimed)), std::vector<int>{10});
+  EXPECT_EQ(push(queue, entry(1, 13)), std::vector<int>{11});
+  EXPECT_EQ(queue.size(), 2U);
+}
+
+TEST(FrameQueueTest, EvictsLowestPriorityWhenFull) {
+  Queue queue(2);
+  push(queue, entry(2, 20));
+  push(queue, entry(1, 10));
+  EXPECT_EQ(push(queue, entry(3, 30)), std::vector<int>{10});
+  EXPECT_EQ(pop_item(queue), 30);
+  EXPECT_EQ(pop_item(queue), 20);
+}
+
+TEST(FrameQueueTest, HandsBackFrameThatRanksLowestWhenFull) {
+  Queue queue(2);
+  push(queue, entry(2, 20));
+  push(queue, entry(3, 30));
+  std::vector<Queue::Entry> displaced;
+  const auto rejected = queue.push(entry(1, 10), displaced);
+  ASSERT_TRUE(rejected.has_value());
+  EXPECT_EQ(rejected->item, 10);
+  EXPECT_TRUE(displaced.empty());
+  EXPECT_EQ(queue.size(), 2U);
+}
+
+TEST(FrameQueueTest, ExpiresFramesPastTheirTtl) {
+  Queue queue(4);
+  auto short_lived = entry(2, 20);
+  short_lived.expires = NOW + seconds(5);
+  auto long_lived = entry(1, 10);
+  long_lived.expires = NOW + seconds(60);
+  push(queue, std::move(short_lived));
+  push(queue, std::move(long_lived));
+  push(queue, entry(0, 0));
+
+  EXPECT_TRUE(queue.take_expired(NOW + seconds(4)).empty());
+  const auto expired = queue.take_expired(NOW + seconds(5));
+  ASSERT_EQ(expired.size(), 1U);
+  EXPECT_EQ(expired.front().item, 20);
+  EXPECT_EQ(queue.size(), 2U);
+}
+
+TEST(FrameQueueTest, HoldsTimedFrameUntilItsStart) {
+  Queue queue(4);
+  auto timed = entry(1, 10);
+  timed.start = NOW + seconds(60);
+  push(queue, std::move(timed));
+
+  EXPECT_EQ(pop_item(queue), std::nullopt);
+  EXPECT_EQ(queue.next_start(NOW), NOW + seconds(60));
+  EXPECT_EQ(pop_item(queue, NOW + seconds(60)), 10);
+  EXPECT_EQ(queue.next_start(NOW), std::nullopt);
+}
+
+TEST(FrameQueueTest, LowerFrameOnlyRunsIfDoneBeforeTimedFrame) {
+  Queue queue(4);
+  auto timed = entry(2, 20);
+  timed.start = NOW + seconds(60);
+  push(queue, std::move(timed));
+  push(queue, entry(1, 10));
+
+  EXPECT_EQ(pop_item(queue, NOW + seconds(40)), std::nullopt);
+  EXPECT_EQ(pop_item(queue, NOW + seconds(20)), 10);
+}
+
+}  // namespace